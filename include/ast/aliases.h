@@ -20,7 +20,6 @@
 
 #include "ast/ast.h"
 #include "ast/print.h"
-#include "lexer/tools.h"
 
 /**
  * An alias to the function `cc_print_ast`.
@@ -30,7 +29,9 @@
 void exporta(void* raiz);
 
 /**
- * An alias to the function `cc_free_ast`. Also cleans up flex's `yylinebuf`.
+ * Kept only for the API: the tree, its symbols and names belong to the
+ * context of its compilation and are released along with it, through
+ * `cc_free_context`.
  *
  * @param raiz the void pointer to a `cc_ast_t` object.
  */
@@ -20,7 +20,6 @@
 #ifndef _AST_H_
 #define _AST_H_
 
-#include <stdarg.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -94,37 +93,63 @@ typedef enum {
 } cc_node_data_kind_t;
 
 typedef union {
-    char* id;
+    char const* id; /* always interned */
     cc_literal_t lit;
     cc_expression_t expr;
     cc_command_t cmd;
 } cc_node_data_t;
 
+/* defined in "semantics/values.h", which depends on this header */
+struct cc_symb_s;
+
+/* defined in "parser/context.h", which depends on this header */
+typedef struct cc_context_s cc_context_t;
+
 typedef struct {
     cc_node_data_t data;
     cc_node_data_kind_t kind;
     cc_location_t location;
     cc_type_t type;
+    struct cc_symb_s* symbol; /* what an identifier resolved to, or `NULL` */
 } cc_lexic_value_t;
 
+/* the children are stored right after the node itself */
 typedef struct cc_ast_s {
     cc_lexic_value_t* content;
-    uint8_t num_children;
-    struct cc_ast_s** children;
     struct cc_ast_s* next;
+    uint8_t num_children;
+    struct cc_ast_s* children[];
 } cc_ast_t;
 
-/* pointer to global abstract syntax tree */
-extern cc_ast_t* ast_g;
-/* pointer to the alias of ast_g, arvore (again, terrible name) */
-extern void*     arvore;
+/* a sequence of nodes linked through `next`, which also knows its last
+ * node, so appending to it doesn't need to walk it */
+typedef struct {
+    cc_ast_t* head;
+    cc_ast_t* tail;
+} cc_ast_chain_t;
 
 /* --------------------------------------------------------------------------- */
 /* Function declarations: */
 
 /**
- * Creates a new lexic value in dynamic memory.
+ * Copies the  first `length`  characters of `text`  to the  AST storage,
+ * so the copy lives exactly as long as the tree does.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param text the original string.
+ * @param length how many characters to copy.
  *
+ * @return the null terminated copy.
+ */
+char* cc_create_ast_string(
+    cc_context_t* context,
+    char const*   text,
+    size_t        length);
+
+/**
+ * Creates a new lexic value in the AST storage.
+ *
+ * @param context the compilation the tree belongs to.
  * @param data the new lexic value data (a union, check above).
  * @param kind the type of node, an enum.
  * @param type the type of the given lexic value.
@@ -135,39 +160,131 @@ extern void*     arvore;
  * @see the header "lexer/location.h".
  */
 cc_lexic_value_t* cc_create_lexic_value(
+    cc_context_t*       context,
     cc_node_data_t      data,
     cc_node_data_kind_t kind,
     cc_type_t           type,
     cc_location_t       loc);
 
 /**
- * Creates a  new AST  node in  dynamic memory.  The last  argument must
- * always be `NULL`, even when there are no children nodes.
+ * Creates a new AST node without children in the AST storage.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param content a pointer to the lexic value you wish to assign to the node.
+ *
+ * @return the address of the created `cc_ast_t`.
+ */
+cc_ast_t* cc_create_leaf_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content);
+
+/**
+ * Creates a new AST node with a single child in the AST storage.
+ *
+ * A `NULL` child, as an empty block, ends the children of the node, so
+ * any child after it is left out. The same goes for all the constructors
+ * below.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param content a pointer to the lexic value you wish to assign to the node.
+ * @param first the child.
+ *
+ * @return the address of the created `cc_ast_t`.
+ */
+cc_ast_t* cc_create_unary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first);
+
+/**
+ * Creates a new AST node with up to two children in the AST storage.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param content a pointer to the lexic value you wish to assign to the node.
+ * @param first the first child.
+ * @param second the second child.
+ *
+ * @return the address of the created `cc_ast_t`.
+ */
+cc_ast_t* cc_create_binary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first,
+    cc_ast_t*         second);
+
+/**
+ * Creates a new AST node with up to three children in the AST storage.
  *
+ * @param context the compilation the tree belongs to.
  * @param content a pointer to the lexic value you wish to assign to the node.
- * @param next a pointer to the next command, if there is any.
- * @param elipse a list of addresses to the children of this node, ALWAYS terminated by a `NULL`.
+ * @param first the first child.
+ * @param second the second child.
+ * @param third the third child.
  *
  * @return the address of the created `cc_ast_t`.
  */
-cc_ast_t* cc_create_ast_node(
+cc_ast_t* cc_create_ternary_ast_node(
+    cc_context_t*     context,
     cc_lexic_value_t* content,
-    cc_ast_t*         next,
-    ...                  );
+    cc_ast_t*         first,
+    cc_ast_t*         second,
+    cc_ast_t*         third);
+
+/**
+ * Creates a new AST node with up to four children in the AST storage.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param content a pointer to the lexic value you wish to assign to the node.
+ * @param first the first child.
+ * @param second the second child.
+ * @param third the third child.
+ * @param fourth the fourth child.
+ *
+ * @return the address of the created `cc_ast_t`.
+ */
+cc_ast_t* cc_create_quaternary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first,
+    cc_ast_t*         second,
+    cc_ast_t*         third,
+    cc_ast_t*         fourth);
+
+/**
+ * Starts a sequence with the given node, which must not be part of one.
+ *
+ * @param first a pointer to the first node, can be `NULL`.
+ *
+ * @return the sequence.
+ */
+cc_ast_chain_t cc_create_ast_chain(cc_ast_t* first);
+
+/**
+ * Appends a single node, which must not  be part of a sequence, to the
+ * end of a sequence, in constant time.
+ *
+ * @param chain the sequence.
+ * @param node a pointer to the node to append, can be `NULL`.
+ *
+ * @return the sequence with the node appended.
+ */
+cc_ast_chain_t cc_append_ast_chain(
+    cc_ast_chain_t chain,
+    cc_ast_t*      node);
 
 /**
- * Given two  nodes, set the  second node as  the next in  the (possible
- * multiple) first node(s). If the first  node is `NULL`, we just return
- * the second node
+ * Appends a whole sequence to the end of another, in constant time, as
+ * both know their last node. Sequences spliced into others, as blocks
+ * and declarations are, must be joined this way.
  *
- * @param first a pointer to the first node. It can already have next nodes set.
- * @param second the future next node of the sequence.
+ * @param first the sequence.
+ * @param second the sequence to append, can be empty.
  *
- * @return the first node in the list.
+ * @return the sequence with the other one appended.
  */
-cc_ast_t* cc_set_next_ast_node(
-    cc_ast_t* first,
-    cc_ast_t* second);
+cc_ast_chain_t cc_concat_ast_chain(
+    cc_ast_chain_t first,
+    cc_ast_chain_t second);
 
 /**
  * Gets the  Nth child of the  given parent node. Returns  `NULL` if the
@@ -184,25 +301,13 @@ cc_ast_t* cc_get_nth_child_node(
     uint8_t   ordinal);
 
 /**
- * Frees a lexic value type, given a pointer to it.
- *
- * @param value the pointer to the value.
- */
-void cc_free_lexic_value(cc_lexic_value_t* value);
-
-/**
- * Frees a single node of an AST, given a pointer to it.
- *
- * @param node the pointer to the node.
- */
-void cc_free_ast_node(cc_ast_t* node);
-
-/**
- * Frees an entire AST given its root pointer.
+ * Frees every AST node,  lexic value and  string of a compilation. As all
+ * of them are  carved from the same arena, they're  all released at once
+ * and there's no way to free a single node.
  *
- * @param ast the root of the AST.
+ * @param context the compilation the tree belongs to.
  */
-void cc_free_ast(cc_ast_t* ast);
+void cc_free_ast(cc_context_t* context);
 
 /**
  * Inverts the signal of the given `cc_literal_t` if it's a numeric literal.
@@ -219,11 +324,14 @@ void cc_invert_number_literal(
     cc_type_t       type);
 
 /**
- * Function  that  encapsulates  the  update  of  the  global  variables
- * pointing to the start of the AST.
+ * Function  that  encapsulates  the update  of the  root of  the AST of a
+ * compilation.
  *
+ * @param context the compilation the tree belongs to.
  * @param new_value the new value to be set.
  */
-void cc_update_global_ast(cc_ast_t* new_value);
+void cc_update_global_ast(
+    cc_context_t* context,
+    cc_ast_t*     new_value);
 
 #endif /* _AST_H_ */
@@ -0,0 +1,162 @@
+/** @file ast/binary.h
+ *
+ * @brief A binary file format for trees, usable right off `mmap`.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * A binary tree file holds, in this order:
+ *
+ * - a header, telling the format and its version, how many nodes there
+ *   are, which is the root and where the strings are;
+ * - the nodes, as fixed size records laid out just like in a compact
+ *   tree, see "ast/compact.h": the children of a node are contiguous and
+ *   nodes refer to each other by their index, always to nodes after
+ *   themselves;
+ * - the strings, each followed by a null character, and each only once.
+ *
+ * A node holding a string (identifiers, functions, calls and string
+ * literals) stores the offset of the string in its section, other
+ * literals store their value right in the record.
+ *
+ * Everything is in the byte order of the machine that wrote the file; a
+ * file from another one fails the version check. Opening a file checks
+ * only its header, so it takes the same time whatever its size, and the
+ * nodes are checked as they're read instead.
+ */
+
+#ifndef _AST_BINARY_H_
+#define _AST_BINARY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ast/ast.h"
+#include "ast/compact.h"
+#include "lexer/input.h"
+#include "utils/map.h"
+#include "utils/memory.h"
+#include "utils/output.h"
+
+/* the first bytes of every binary tree file */
+#define BINARY_AST_MAGIC "CCAS"
+
+/* the version of the format, bumped on every change to it */
+#define BINARY_AST_VERSION ((uint16_t)1)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    char         magic[4];     /** Always `BINARY_AST_MAGIC`. */
+    uint16_t     version;      /** Always `BINARY_AST_VERSION`. */
+    uint16_t     node_size;    /** The size of a node record. */
+    uint32_t     count;        /** How many nodes there are. */
+    cc_node_id_t root;         /** The first node, or `NO_NODE_ID` if empty. */
+    uint64_t     strings;      /** Where the strings start in the file. */
+    uint64_t     strings_size; /** How many bytes of strings there are. */
+} cc_binary_header_t;
+
+typedef struct {
+    uint64_t     value;        /** The offset of its string, or its literal value. */
+    uint32_t     line;         /** The line it was matched at. */
+    uint32_t     column;       /** The column it was matched at. */
+    uint16_t     length;       /** How many columns it spans. */
+    uint8_t      kind;         /** A `cc_node_data_kind_t`. */
+    uint8_t      type;         /** A `cc_type_t`. */
+    uint8_t      num_children; /** How many children it has. */
+    uint8_t      reserved[3];  /** Always zero. */
+    cc_node_id_t children;     /** Its first child, followed by the others. */
+    cc_node_id_t next;         /** The next node of its sequence. */
+} cc_binary_node_t;
+
+typedef struct {
+    cc_input_t*               input;   /** The file, mapped if possible. */
+    cc_binary_header_t const* header;  /** Its header. */
+    cc_binary_node_t const*   nodes;   /** Its nodes. */
+    char const*               strings; /** Its strings. */
+} cc_binary_ast_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Writes a compact tree in the binary format.
+ *
+ * @param output where to write the tree.
+ * @param ast the compact tree.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_write_binary_ast(
+    cc_output_t*            output,
+    cc_compact_ast_t const* ast);
+
+/**
+ * Opens a binary tree file, mapping it in memory when possible.
+ *
+ * @param path the path of the file, or `NULL` for the standard input.
+ *
+ * @return a pointer to the tree or `NULL` if the file couldn't be read or
+ *         isn't a binary tree of this version.
+ */
+cc_binary_ast_t* cc_open_binary_ast(char const* path);
+
+/**
+ * Gets a node of a binary tree.
+ *
+ * @param ast the binary tree.
+ * @param id the node.
+ *
+ * @return a pointer to the node, in the file, or `NULL` if there's no such
+ *         node.
+ */
+cc_binary_node_t const* cc_get_binary_node(
+    cc_binary_ast_t const* ast,
+    cc_node_id_t           id);
+
+/**
+ * Gets what a node of a binary tree holds, with its string, if it has one,
+ * pointing into the file.
+ *
+ * @param ast the binary tree.
+ * @param id the node.
+ * @param data where to store what the node holds.
+ *
+ * @return whether the node is sound: in the file, of a known kind and
+ *         type, with its string in the file and its children and next
+ *         node after it.
+ */
+bool cc_get_binary_data(
+    cc_binary_ast_t const* ast,
+    cc_node_id_t           id,
+    cc_node_data_t*        data);
+
+/**
+ * Creates a compact tree out of a binary one, checking every node. Its
+ * strings point into the file, which must outlive it.
+ *
+ * @param ast the binary tree.
+ *
+ * @return a pointer to the compact tree, allocated in dynamic memory, or
+ *         `NULL` if a node isn't sound.
+ */
+cc_compact_ast_t* cc_load_compact_ast(cc_binary_ast_t const* ast);
+
+/**
+ * Closes a binary tree file.
+ *
+ * @param ast the binary tree, can be `NULL`.
+ */
+void cc_close_binary_ast(cc_binary_ast_t* ast);
+
+#endif /* _AST_BINARY_H_ */
@@ -0,0 +1,111 @@
+/** @file ast/compact.h
+ *
+ * @brief An abstract syntax tree in contiguous storage.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * A compact tree keeps all of its nodes in a single growable array, with
+ * the content of each node inline, and refers to other nodes by their
+ * 32-bit index in it. The children of a node sit next to each other, so
+ * the Nth child is just an offset away from the first one.
+ *
+ * A node takes 32 bytes this way, against the 24 bytes of a `cc_ast_t`,
+ * 8 per child and the 40 of its separate lexic value. String literals
+ * are copied along, so the tree it was made from can be freed as soon as
+ * the copy is done, while names, being interned, stay with the context
+ * and the symbols are left out.
+ */
+
+#ifndef _AST_COMPACT_H_
+#define _AST_COMPACT_H_
+
+#include <stdint.h>
+
+#include "ast/ast.h"
+#include "utils/memory.h"
+
+/* the index of a node in a compact tree */
+typedef uint32_t cc_node_id_t;
+
+/* the index of no node at all */
+#define NO_NODE_ID UINT32_MAX
+
+/* smallest capacity of a compact tree */
+#define DEFAULT_COMPACT_AST_SIZE ((uint32_t)1024)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    cc_node_data_t data;         /** What the node holds, as in its lexic value. */
+    cc_location_t  location;     /** Where it was matched. */
+    uint8_t        kind;         /** A `cc_node_data_kind_t`. */
+    uint8_t        type;         /** A `cc_type_t`. */
+    uint8_t        num_children; /** How many children it has. */
+    cc_node_id_t   children;     /** Its first child, followed by the others. */
+    cc_node_id_t   next;         /** The next node of its sequence. */
+} cc_compact_node_t;
+
+typedef struct {
+    cc_compact_node_t* nodes;    /** Every node of the tree. */
+    uint32_t           count;    /** How many nodes there are. */
+    uint32_t           capacity; /** How many nodes fit in `nodes`. */
+    cc_node_id_t       root;     /** The first node, or `NO_NODE_ID` if empty. */
+    cc_arena_t*        strings;  /** Its string literals, `NULL` if they're borrowed. */
+} cc_compact_ast_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Creates the compact version of a tree, which no longer needs the tree
+ * once created. The names still belong to the context of the tree.
+ *
+ * @param ast the tree, can be `NULL`.
+ *
+ * @return a pointer to the compact tree, allocated in dynamic memory.
+ */
+cc_compact_ast_t* cc_create_compact_ast(cc_ast_t const* ast);
+
+/**
+ * Creates the compact version of the tree of a context, and then frees
+ * the tree, so both are only around at once while copying.
+ *
+ * @param context the compilation.
+ *
+ * @return a pointer to the compact tree, allocated in dynamic memory.
+ */
+cc_compact_ast_t* cc_take_compact_ast(cc_context_t* context);
+
+/**
+ * Gets the Nth child of the given node, just like `cc_get_nth_child_node`.
+ *
+ * @param ast the compact tree.
+ * @param parent the parent node.
+ * @param ordinal the ordinal position of the child.
+ *
+ * @return the child, or `NO_NODE_ID` if there isn't one.
+ */
+cc_node_id_t cc_get_nth_child_compact(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            parent,
+    uint8_t                 ordinal);
+
+/**
+ * Frees a compact tree, along with its string literals unless borrowed.
+ *
+ * @param ast the compact tree, can be `NULL`.
+ */
+void cc_free_compact_ast(cc_compact_ast_t* ast);
+
+#endif /* _AST_COMPACT_H_ */
@@ -0,0 +1,101 @@
+/** @file ast/dot.h
+ *
+ * @brief Fast export of trees, with nodes numbered in order.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * A writer exports trees in the same format, and with the lines in the
+ * same order, as `cc_print_ast`, but names each node by a sequential id
+ * instead of its address: the root is 0 and every other node gets the
+ * next id when it's first mentioned. The output is thus the same from
+ * run to run, and for a tree and its compact copy.
+ *
+ * Everything goes through an output, see "utils/output.h", and the
+ * writer may be kept for the next export.
+ */
+
+#ifndef _AST_DOT_H_
+#define _AST_DOT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ast/ast.h"
+#include "ast/compact.h"
+#include "utils/memory.h"
+#include "utils/output.h"
+
+/* initial capacity of the id stacks of a writer */
+#define DEFAULT_DOT_STACK_SIZE ((uint32_t)64)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    cc_output_t* output;  /** Where the tree goes. */
+    uint32_t     count;   /** How many ids were handed out so far. */
+    uint32_t*    pending; /** Ids of the nodes mentioned but not reached yet. */
+    uint32_t     waiting; /** How many ids are pending. */
+    uint32_t*    open;    /** Ids of the nodes reached but not labeled yet. */
+    uint32_t     opened;  /** How many ids are open. */
+    uint32_t     size;    /** How many ids fit in each of the stacks. */
+} cc_dot_writer_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Creates a writer to the given output, which is left to the caller.
+ *
+ * @param output where the trees go.
+ *
+ * @return a pointer to the writer, allocated in dynamic memory.
+ */
+cc_dot_writer_t* cc_create_dot_writer(cc_output_t* output);
+
+/**
+ * Exports a tree from the given node on and writes it all out.
+ *
+ * @param writer the writer.
+ * @param ast the first node, can be `NULL`.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_write_dot_ast(
+    cc_dot_writer_t* writer,
+    cc_ast_t const*  ast);
+
+/**
+ * Exports a compact tree from the given node on and writes it all out,
+ * exactly as the tree it was made from would be.
+ *
+ * @param writer the writer.
+ * @param ast the compact tree.
+ * @param id the first node, usually the root.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_write_dot_compact_ast(
+    cc_dot_writer_t*        writer,
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id);
+
+/**
+ * Frees a writer, without flushing it.
+ *
+ * @param writer the writer, can be `NULL`.
+ */
+void cc_free_dot_writer(cc_dot_writer_t* writer);
+
+#endif /* _AST_DOT_H_ */
@@ -0,0 +1,62 @@
+/** @file ast/json.h
+ *
+ * @brief Export of trees as JSON.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * A tree is written as a JSON array holding the sequence of its top level
+ * nodes, usually the functions. Each node is an object such as:
+ *
+ *     {"kind":"expr","type":"int","value":"+","line":3,"column":9,
+ *      "length":1,"symbol":{...},"children":[[...],[...]]}
+ *
+ * - `kind` is one of "id", "lit", "expr", "cmd", "func" or "call";
+ * - `type` is one of "int", "float", "char", "bool", "string" or "undef";
+ * - `value` is the name of identifiers, functions and calls, the value of
+ *   literals, or the operator or keyword of expressions and commands;
+ * - `symbol` is only there for identifiers resolved to a declaration, and
+ *   holds its "kind" ("var", "func" or "array"), "type", "size", "line"
+ *   and "column";
+ * - `children` holds a sequence, that is, an array of nodes, per child,
+ *   as a child may be followed by more nodes, the statements of a block
+ *   for instance.
+ *
+ * Sequences are arrays rather than nested objects, so readers don't need
+ * to go deeper than the nesting of the source. The tree is written in a
+ * single walk, straight to an output, taking no memory per node.
+ */
+
+#ifndef _AST_JSON_H_
+#define _AST_JSON_H_
+
+#include <stdbool.h>
+
+#include "ast/ast.h"
+#include "utils/output.h"
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Exports a tree from the given node on and writes it all out.
+ *
+ * @param output where to write the tree.
+ * @param ast the first node, can be `NULL` for an empty tree.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_write_json_ast(
+    cc_output_t*    output,
+    cc_ast_t const* ast);
+
+#endif /* _AST_JSON_H_ */
@@ -21,6 +21,7 @@
 #include <stdio.h>
 
 #include "ast/ast.h"
+#include "ast/compact.h"
 
 /**
  * Prints all children of a `cc_ast_t` node in CSV format. Every line
@@ -30,6 +31,31 @@
  */
 void cc_print_ast_children(cc_ast_t const* restrict node);
 
+/**
+ * Tells the fixed label of expression and command nodes, which is the
+ * operator or the keyword they stand for.
+ *
+ * @param kind the kind of the node.
+ * @param data its data.
+ *
+ * @return the label, or `NULL` if the node's label depends on its data.
+ */
+char const* cc_get_ast_symbol(
+    cc_node_data_kind_t kind,
+    cc_node_data_t      data);
+
+/**
+ * Prints what a node holds, as it's shown in its label.
+ *
+ * @param kind the kind of the node.
+ * @param type its type.
+ * @param data its data.
+ */
+void cc_print_ast_label(
+    cc_node_data_kind_t kind,
+    cc_type_t           type,
+    cc_node_data_t      data);
+
 /**
  * Prints the content of a `cc_ast_t` node, respecting its content.
  *
@@ -45,4 +71,16 @@ void cc_print_ast_node(cc_ast_t const* restrict node);
  */
 void cc_print_ast(cc_ast_t const* restrict ast);
 
+/**
+ * Prints a compact tree from the given node on, just as `cc_print_ast`
+ * prints the tree it was made from, with the addresses of the compact
+ * nodes instead.
+ *
+ * @param ast a pointer to the compact tree.
+ * @param id the node to start from, usually the root.
+ */
+void cc_print_compact_ast(
+    cc_compact_ast_t const* restrict ast,
+    cc_node_id_t                     id);
+
 #endif /* _PRINT_H_ */
@@ -0,0 +1,87 @@
+/** @file ast/walk.h
+ *
+ * @brief Traversal of trees without recursion.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * A walk goes  through a node, its children, in order,  and then every
+ * node after it in its  sequence, calling back a visitor along the way.
+ * Each node gets up to three calls:
+ *
+ * - `pre`, when it's reached, which may skip its children;
+ * - `visit`, once its children were walked;
+ * - `post`, once the rest of its sequence was walked as well.
+ *
+ * Where the nodes still to be finished are kept in an explicit stack, so
+ * walks take the same C stack however long the sequences or deep the
+ * nesting. Without a `post` callback a sequence doesn't even take room
+ * in that stack, as each node is done with before the next one.
+ */
+
+#ifndef _AST_WALK_H_
+#define _AST_WALK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ast/ast.h"
+#include "ast/compact.h"
+#include "utils/memory.h"
+
+/* initial capacity of the stack of a walk */
+#define DEFAULT_WALK_STACK_SIZE ((uint32_t)64)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    bool (*pre)(cc_ast_t const* node, void* data);   /** Returns whether to walk the children. */
+    void (*visit)(cc_ast_t const* node, void* data); /** After the children. */
+    void (*post)(cc_ast_t const* node, void* data);  /** After the rest of the sequence. */
+    void* data;                                      /** Handed to every callback. */
+} cc_ast_visitor_t;
+
+typedef struct {
+    bool (*pre)(cc_compact_ast_t const* ast, cc_node_id_t id, void* data);   /** Returns whether to walk the children. */
+    void (*visit)(cc_compact_ast_t const* ast, cc_node_id_t id, void* data); /** After the children. */
+    void (*post)(cc_compact_ast_t const* ast, cc_node_id_t id, void* data);  /** After the rest of the sequence. */
+    void* data;                                                              /** Handed to every callback. */
+} cc_compact_ast_visitor_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Walks a tree from the given node on. Any of the callbacks may be
+ * `NULL`, in which case every child is walked.
+ *
+ * @param ast the first node, can be `NULL`.
+ * @param visitor what to call back.
+ */
+void cc_walk_ast(
+    cc_ast_t const*         ast,
+    cc_ast_visitor_t const* visitor);
+
+/**
+ * Walks a compact tree from the given node on, just like `cc_walk_ast`.
+ *
+ * @param ast the compact tree.
+ * @param id the first node, can be `NO_NODE_ID`.
+ * @param visitor what to call back.
+ */
+void cc_walk_compact_ast(
+    cc_compact_ast_t const*         ast,
+    cc_node_id_t                    id,
+    cc_compact_ast_visitor_t const* visitor);
+
+#endif /* _AST_WALK_H_ */
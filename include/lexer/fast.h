@@ -0,0 +1,107 @@
+/** @file lexer/fast.h
+ *
+ * @brief Hand-written scanner, an alternative to the flex one.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Produces exactly  the same  tokens, values and  locations as  the flex
+ * specification in  "lexer/scanner.l", down to the  column bookkeeping,
+ * but dispatches on the first character of each token instead of running
+ * a DFA byte by byte.  Whitespace, comments, string literals and words
+ * are skipped with SSE2 (or AVX2, when  available) 16 or 32 bytes at a
+ * time, and byte by byte everywhere else.
+ *
+ * Whenever the flex specification changes, this scanner must follow, and
+ * "test/lexer.sh" compares both over every test case.
+ */
+
+#ifndef _LEXER_FAST_H_
+#define _LEXER_FAST_H_
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ast/ast.h"
+#include "lexer/keywords.h"
+#include "lexer/tools.h"
+#include "utils/intern.h"
+#include "utils/text.h"
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    char*    text;       /** Where the input starts. */
+    char*    cursor;     /** Where we are. */
+    char*    limit;      /** Where the input ends, so far. */
+    bool     partial;    /** Whether more input may still follow `limit`. */
+    int      column;     /** The column of `cursor`, as `yycolumn` in flex. */
+    bool     in_comment; /** Whether we're inside a block comment. */
+    YYSTYPE* value;      /** Where the value of the current token goes. */
+} cc_fast_lexer_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Sets the text the fast scanner of a compilation reads from and rewinds
+ * it. The text is scanned in place, so it must be writable and outlive
+ * the scanning.
+ *
+ * @param context the compilation.
+ * @param text the input, followed by at least one null character.
+ * @param length how many characters of input there are.
+ */
+void cc_set_input_fast_lexer(
+    cc_context_t* context,
+    char*         text,
+    size_t        length);
+
+/**
+ * Lets the fast scanner of a compilation go further into its input, which
+ * may have been moved elsewhere meanwhile, without rewinding it.
+ *
+ * While the input is partial, scanning stops at `length` as if the input
+ * ended there, except that a block comment left open isn't an error, so
+ * `length` must be right after a newline, where no other token can be cut
+ * in half.
+ *
+ * @param context the compilation.
+ * @param text the input, with everything scanned so far left in place.
+ * @param length how many characters of input there are now.
+ * @param partial whether more input may still come after these.
+ */
+void cc_extend_input_fast_lexer(
+    cc_context_t* context,
+    char*         text,
+    size_t        length,
+    bool          partial);
+
+/**
+ * Scans the next token, just like the flex scanner would, setting the
+ * location and line of the compilation accordingly.
+ *
+ * @param value where to store the semantic value of the token.
+ * @param context the compilation.
+ *
+ * @return the token, or 0 at the end of the input.
+ */
+int cc_fast_lex(
+    YYSTYPE*      value,
+    cc_context_t* context);
+
+#endif /* _LEXER_FAST_H_ */
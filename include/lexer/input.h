@@ -0,0 +1,75 @@
+/** @file lexer/input.h
+ *
+ * @brief Source input handed to the scanner.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * The whole source is made available  in memory before scanning starts,
+ * so flex can scan it in place  and diagnostics can point back into it.
+ * Regular files, be them given by name or redirected to the standard
+ * input, are mapped with `mmap`.  Anything else (pipes, terminals) is
+ * read into a heap buffer instead.
+ */
+
+#ifndef _LEXER_INPUT_H_
+#define _LEXER_INPUT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "utils/memory.h"
+
+/* initial size of the buffer of inputs that can't be mapped */
+#define DEFAULT_INPUT_BUFFER_SIZE ((size_t)65536)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    char*  text;   /** The source, followed by two null characters. */
+    size_t length; /** How many characters of source there are. */
+    size_t mapped; /** The size of the mapping, or 0 if in the heap. */
+} cc_input_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Makes the contents of the given file available in memory.
+ *
+ * @param path the path of the source file, or `NULL` for the standard
+ *             input.
+ *
+ * @return a pointer to the input or `NULL` if it couldn't be read.
+ */
+cc_input_t* cc_open_input(char const* path);
+
+/**
+ * Makes room in the heap for an input of the given length, to be filled
+ * in by the caller. The two null characters after it are already there.
+ *
+ * @param length how many characters of source there will be.
+ *
+ * @return a pointer to the input.
+ */
+cc_input_t* cc_create_input(size_t length);
+
+/**
+ * Releases an input, unmapping or freeing its text.
+ *
+ * @param input the input to close.
+ */
+void cc_close_input(cc_input_t* input);
+
+#endif /* _LEXER_INPUT_H_ */
@@ -0,0 +1,71 @@
+/** @file lexer/keywords.h
+ *
+ * @brief Reserved words of the language.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * The scanner matches every word with the same rule, and only then asks
+ * this module whether it is reserved. The lookup is a perfect hash: each
+ * keyword has a slot of its own in a small table, so it costs a handful
+ * of arithmetic and at most one comparison.
+ */
+
+#ifndef _LEXER_KEYWORDS_H_
+#define _LEXER_KEYWORDS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ast/ast.h"
+#include "parser/parser.tab.h"
+#include "semantics/types.h"
+
+/* size of the keyword table, a power of two */
+#define KEYWORD_TABLE_SIZE ((uint32_t)64)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef enum {
+    cc_keyword_plain,   /** Carries no value at all. */
+    cc_keyword_type,    /** Carries the `cc_type_t` it names. */
+    cc_keyword_command, /** Carries a lexic value with a `cc_command_t`. */
+    cc_keyword_literal  /** Carries a lexic value with a boolean literal. */
+} cc_keyword_kind_t;
+
+typedef struct {
+    char const*       name;   /** The keyword itself, or `NULL` if the slot is empty. */
+    uint8_t           length; /** How many characters it has. */
+    int               token;  /** The token it is scanned as. */
+    cc_keyword_kind_t kind;   /** What kind of value goes along with the token. */
+    int               value;  /** Said value: a type, a command or a boolean. */
+} cc_keyword_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Searches for a keyword matching the given word.
+ *
+ * @param word the matched word, not necessarily null terminated.
+ * @param length how many characters it has.
+ *
+ * @return the keyword or `NULL` if the word isn't reserved.
+ */
+cc_keyword_t const* cc_find_keyword(
+    char const* word,
+    size_t      length);
+
+#endif /* _LEXER_KEYWORDS_H_ */
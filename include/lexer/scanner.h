@@ -21,19 +21,54 @@
 #ifndef _SCANNER_H_
 #define _SCANNER_H_
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "ast/ast.h"
+#include "lexer/fast.h"
+#include "lexer/input.h"
+#include "lexer/keywords.h"
+#include "lexer/tokens.h"
 #include "lexer/tools.h"
 #include "utils/debug.h"
+#include "utils/intern.h"
 #include "utils/text.h"
 
-extern int yylex(void);
-extern int yylex_destroy(void);
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
 
-extern FILE* yyin;
-extern char* yytext;
-extern int   yycolumn;
+/**
+ * Sets the given input as the one the scanners of a compilation read from,
+ * without copying it. The input must be kept open until scanning is over.
+ *
+ * @param context the compilation.
+ * @param input the input to scan.
+ *
+ * @return whether flex accepted the input.
+ */
+bool cc_scan_input(
+    cc_context_t* context,
+    cc_input_t*   input);
+
+/**
+ * Scans the next token with the selected scanner, regardless of whether
+ * the parser is being fed from a token array.
+ *
+ * @param value where to store the semantic value of the token.
+ * @param context the compilation.
+ *
+ * @return the token, or 0 at the end of the input.
+ */
+int cc_scan_token(
+    YYSTYPE*      value,
+    cc_context_t* context);
+
+/**
+ * Frees the flex scanner of a compilation, if it was ever created.
+ *
+ * @param context the compilation.
+ */
+void cc_free_scanner(cc_context_t* context);
 
 #endif /* _SCANNER_H_ */
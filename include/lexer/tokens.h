@@ -0,0 +1,106 @@
+/** @file lexer/tokens.h
+ *
+ * @brief Whole input scanned ahead of parsing.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Instead of  having the parser  pull each token  from the scanner, the
+ * whole input may be scanned beforehand into a token array, from which
+ * the parser is then fed. That way scanning and parsing can be measured
+ * (and tuned) separately.
+ *
+ * The array is laid out as a structure of arrays, with one array per
+ * field of the tokens, so that the parser only touches the memory of the
+ * fields it reads. Semantic values are only stored for tokens that have
+ * one, and each token holds the index of its own.
+ */
+
+#ifndef _LEXER_TOKENS_H_
+#define _LEXER_TOKENS_H_
+
+#include <stdint.h>
+
+#include "lexer/input.h"
+#include "lexer/tools.h"
+#include "parser/parser.tab.h"
+#include "utils/memory.h"
+
+/* smallest capacity of a token array */
+#define DEFAULT_TOKEN_ARRAY_SIZE ((uint32_t)1024)
+
+/* roughly how many characters of input make up a token */
+#define CHARS_PER_TOKEN ((size_t)4)
+
+/* the value index of tokens without a semantic value */
+#define NO_TOKEN_VALUE UINT32_MAX
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    uint16_t* kind;   /** What each token is, as returned by the scanner. */
+    uint32_t* line;   /** The line each token was found at. */
+    uint32_t* column; /** The column each token starts at. */
+    uint32_t* length; /** How many columns each token spans. */
+    uint32_t* value;  /** The index of each semantic value, or `NO_TOKEN_VALUE`. */
+    YYSTYPE*  values; /** The semantic values themselves. */
+
+    uint32_t count;          /** How many tokens there are. */
+    uint32_t capacity;       /** How many tokens fit in the arrays. */
+    uint32_t value_count;    /** How many semantic values there are. */
+    uint32_t value_capacity; /** How many semantic values fit in `values`. */
+    uint32_t next;           /** The next token to be handed to the parser. */
+} cc_token_array_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Scans the whole input of a compilation, already set with `cc_scan_input`,
+ * until its end with the selected scanner, storing every token. Lexic
+ * values are still created in the AST storage, just earlier than they'd
+ * be otherwise.  Once the array is set as the `tokens` of the context,
+ * `yylex` hands them out instead of scanning.
+ *
+ * @param context the compilation.
+ * @param input the input being scanned, only used to size the array.
+ *
+ * @return a pointer to the new token array.
+ */
+cc_token_array_t* cc_create_token_array(
+    cc_context_t*     context,
+    cc_input_t const* input);
+
+/**
+ * Hands the next token of the array to the parser, restoring the location
+ * and line of the compilation just as the scanner had left them.
+ *
+ * @param array the token array.
+ * @param value where to store the semantic value of the token.
+ * @param context the compilation.
+ *
+ * @return the token, or 0 once all of them were handed.
+ */
+int cc_next_token_array(
+    cc_token_array_t* array,
+    YYSTYPE*          value,
+    cc_context_t*     context);
+
+/**
+ * Frees a token array. The lexic values it refers to belong to the AST.
+ *
+ * @param array the token array, can be `NULL`.
+ */
+void cc_free_token_array(cc_token_array_t* array);
+
+#endif /* _LEXER_TOKENS_H_ */
@@ -14,85 +14,185 @@
  * @section DESCRIPTION
  *
  * Includes some utilities to printing things in the lexer.
+ *
+ * The whole  input is  in memory while  it's scanned  (see "lexer/input.h"),
+ * so for diagnostics we only keep an array of where each line starts in
+ * it. Fetching any line is then a matter of indexing said array. Each
+ * compilation has its own text buffer, kept in its context.
  */
 
 #ifndef _TOOLS_H_
 #define _TOOLS_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "lexer/location.h"
 #include "parser/parser.tab.h"
-#include "utils/list.h"
 #include "utils/memory.h"
 #include "utils/text.h"
 
 #ifndef VERBOSE
 #define V_LOG_LEXER(STR)      ((void)0)
-#define PRINT_NAME(TOKEN)     printf("%u " #TOKEN " [%s]\n", cc_match_line(), yytext)
-#define PRINT_SPC_NAME(TOKEN) printf("%u TK_ESPECIAL [%c]\n", cc_match_line(), TOKEN)
+#define PRINT_NAME(TOKEN)     printf("%d " #TOKEN " [%s]\n", yylineno, yytext)
+#define PRINT_SPC_NAME(TOKEN) printf("%d TK_ESPECIAL [%c]\n", yylineno, TOKEN)
 #else
-#define V_LOG_LEXER(STR)      printf("\n==> [%d]: " STR " {%s}\n", cc_match_line(), yytext)
+#define V_LOG_LEXER(STR)      printf("\n==> [%d]: " STR " {%s}\n", yylineno, yytext)
 #define PRINT_NAME(TOKEN)     ((void)0)
 #define PRINT_SPC_NAME(TOKEN) ((void)0)
 #endif
 
-extern int yylineno;
+/* initial capacity of the line index */
+#define DEFAULT_LINE_INDEX_SIZE ((uint32_t)256)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    char const* text;          /** The text being scanned, not owned by us. */
+    size_t      length;        /** How many characters `text` has. */
+    size_t*     line_starts;   /** Where each line starts in `text`, the first at index 0. */
+    uint32_t    line_count;    /** How many lines were found so far. */
+    uint32_t    line_capacity; /** How many lines fit in `line_starts`. */
+} cc_text_buffer_t;
 
-extern cc_list_t* yytextbuf;
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Scans the next token of a compilation, be it from flex, the hand-written
+ * scanner or the token array.
+ *
+ * Defined along with the scanner itself, in "lexer/scanner.l".
+ *
+ * @param value where to store the semantic value of the token.
+ * @param location where to store the location of the token.
+ * @param context the compilation.
+ *
+ * @return the token, or 0 at the end of the input.
+ */
+int yylex(
+    YYSTYPE*      value,
+    YYLTYPE*      location,
+    cc_context_t* context);
 
 /**
  * Retrieves the line where the last token was recognized.
  *
+ * @param context the compilation.
+ *
  * @return the line number.
  */
-uint32_t cc_match_line(void);
+uint32_t cc_match_line(cc_context_t* context);
 
 /**
  * Retrieves the column where the last token was recognized.
  *
+ * @param context the compilation.
+ *
  * @return the column number.
  */
-uint32_t cc_match_column(void);
+uint32_t cc_match_column(cc_context_t* context);
 
 /**
  * Calculates the last match length.
  *
+ * @param context the compilation.
+ *
  * @return the last match length.
  */
-uint32_t cc_match_length(void);
+uint32_t cc_match_length(cc_context_t* context);
 
 /**
  * Gets the location (line, column and length) of the last match.
  *
+ * @param context the compilation.
+ *
  * @return the `cc_location_t` of the match.
  *
  * @see the header "lexer/location.h".
  */
-cc_location_t cc_match_location(void);
+cc_location_t cc_match_location(cc_context_t* context);
 
 /**
- * Updates the global line buffer with the contents of `text` up until
- * `match_length`.
+ * Sets the text being scanned, from which lines will be printed. The
+ * text isn't copied, so it must outlive any diagnostic. Its first line
+ * starts right away.
  *
+ * @param context the compilation.
  * @param text the input character array.
- * @param match_length the size of the input character array.
+ * @param length the size of the input character array.
+ */
+void cc_set_text_buffer(
+    cc_context_t* context,
+    char const*   text,
+    size_t        length);
+
+/**
+ * Updates the text being scanned after it was moved or grew, keeping the
+ * lines found so far.
+ *
+ * @param context the compilation.
+ * @param text the input character array, with the old text at its start.
+ * @param length the size of the input character array.
+ */
+void cc_extend_text_buffer(
+    cc_context_t* context,
+    char const*   text,
+    size_t        length);
+
+/**
+ * Marks that a new line of the text starts at `line`, which must point
+ * into the text given to `cc_set_text_buffer`.
+ *
+ * @param context the compilation.
+ * @param line where the line starts.
  */
-void cc_update_text_buffer(
-    char*  text,
-    size_t match_length);
+void cc_mark_line_text_buffer(
+    cc_context_t* context,
+    char const*   line);
+
+/**
+ * Frees the index of lines. The text itself belongs to whoever set it.
+ *
+ * @param context the compilation.
+ */
+void cc_free_text_buffer(cc_context_t* context);
 
 /**
  * Prints a given location of the text, if within the current boundaries
  * of the text.
  *
+ * @param context the compilation.
  * @param location the location of the point we wish to print.
  * @param stream were to print to.
  */
 void cc_print_location(
+    cc_context_t*  context,
     cc_location_t  location,
     FILE* restrict stream);
 
+/**
+ * Whether a token carries a lexic value, according to the grammar.
+ *
+ * @param token the token.
+ *
+ * @return a boolean indicating so.
+ */
+bool cc_has_lexic_value(int token);
+
+/**
+ * Scans the whole input, printing each token along with its location and
+ * value instead of parsing it. Two scanners are equivalent if and only if
+ * they print the same thing for every input.
+ *
+ * @param context the compilation.
+ * @param stream were to print to.
+ */
+void cc_print_tokens(
+    cc_context_t*  context,
+    FILE* restrict stream);
+
 #endif /* _TOOLS_H_ */
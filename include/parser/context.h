@@ -0,0 +1,103 @@
+/** @file parser/context.h
+ *
+ * @brief State of a single compilation.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Everything a compilation keeps track of lives in its context: the state
+ * of both scanners, the text being compiled and its line index, the scope
+ * stack and symbol table, the interned names and the storage of the tree
+ * and its symbols. The scanner is a reentrant flex one and the parser a
+ * pure bison one, both of which receive the context as a parameter.
+ *
+ * Contexts share nothing but the memory statistics, which are updated
+ * atomically, so as many inputs as wanted may be compiled at the same
+ * time, each by its own thread.
+ *
+ * A context may also be reset and given another input, keeping what it
+ * allocated for the previous one: the blocks of its arenas, its interned
+ * names and its line index.
+ */
+
+#ifndef _PARSER_CONTEXT_H_
+#define _PARSER_CONTEXT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ast/ast.h"
+#include "lexer/fast.h"
+#include "lexer/tokens.h"
+#include "lexer/tools.h"
+#include "parser/parser.tab.h"
+#include "utils/intern.h"
+#include "utils/list.h"
+#include "utils/map.h"
+#include "utils/memory.h"
+#include "utils/stack.h"
+
+/* how many names a context reset keeps interned at most */
+#define MAX_KEPT_INTERNED_STRINGS ((uint32_t)65536)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+struct cc_context_s {
+    void*             scanner;      /** The state of the flex scanner, a `yyscan_t`. */
+    cc_fast_lexer_t   fast;         /** The state of the hand-written scanner. */
+    bool              fast_lexer;   /** Whether to scan with the hand-written scanner. */
+    cc_token_array_t* tokens;       /** The tokens scanned ahead of parsing, if any. */
+    YYLTYPE           location;     /** Where the last token was matched. */
+    int               line;         /** The line being scanned, as `yylineno`. */
+    cc_text_buffer_t  text;         /** The text being compiled and its line index. */
+    cc_intern_pool_t  pool;         /** Every name seen so far. */
+    cc_stack_t*       scope;        /** The scope levels currently open. */
+    cc_map_t*         symbol_table; /** The innermost binding of each name. */
+    cc_arena_t*       symbol_arena; /** Storage for the symbols. */
+    cc_list_t*        parameters;   /** The parameters of each function, held by its symbol. */
+    cc_arena_t*       ast_arena;    /** Storage for the tree. */
+    cc_ast_t*         ast;          /** The root of the tree. */
+    FILE*             diagnostics;  /** Where errors are reported, `stderr` by default. */
+};
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Creates an  empty context, ready to  be given an input  with the scanner
+ * function `cc_scan_input` and then parsed with `yyparse`.
+ *
+ * @return a pointer to the context, allocated in dynamic memory.
+ */
+cc_context_t* cc_create_context(void);
+
+/**
+ * Frees a context along with everything it owns: the tree, the symbols,
+ * the scopes, the interned names, the line index, the token array and
+ * the scanner. The input itself belongs to whoever opened it.
+ *
+ * @param context the context, can be `NULL`.
+ */
+void cc_free_context(cc_context_t* context);
+
+/**
+ * Empties a context, so it can be given another input, as if just
+ * created. Its settings are kept, as well as its storage, but for the
+ * scopes, the token array and the scanner.
+ *
+ * @param context the context.
+ */
+void cc_reset_context(cc_context_t* context);
+
+#endif /* _PARSER_CONTEXT_H_ */
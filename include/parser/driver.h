@@ -0,0 +1,156 @@
+/** @file parser/driver.h
+ *
+ * @brief Compilation of many inputs at once.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * The driver compiles a list of inputs on a pool of threads, each input
+ * with a context of its own. Every input is compiled into memory, its
+ * tree to an output and its diagnostics to a stream, and those are then
+ * written, whole, in the order the inputs were given, as soon as all the
+ * inputs before were. The result is thus the same whatever the number of
+ * threads, only faster. So that a slow input doesn't leave every other
+ * one waiting in memory behind it, threads stop taking new inputs while
+ * too much output is pending.
+ *
+ * As the tree of each input must be written apart from the others, it's
+ * never printed with `exporta`, which names nodes by their address, but
+ * as if exporting with `cc_emit_dot`.
+ */
+
+#ifndef _PARSER_DRIVER_H_
+#define _PARSER_DRIVER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ast/ast.h"
+#include "ast/compact.h"
+#include "lexer/input.h"
+#include "parser/context.h"
+#include "utils/memory.h"
+#include "utils/output.h"
+
+/* how much finished output may wait to be written, per thread */
+#define DRIVER_PENDING_OUTPUT_SIZE ((size_t)16 << 20)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+/* what a tree is exported as */
+typedef enum {
+    cc_emit_default, /* whatever `exporta` prints */
+    cc_emit_dot,     /* see "ast/dot.h" */
+    cc_emit_json,    /* see "ast/json.h" */
+    cc_emit_binary   /* see "ast/binary.h" */
+} cc_emit_t;
+
+typedef struct {
+    bool      fast_lexer; /** Whether to scan with the hand-written scanner. */
+    bool      pre_lex;    /** Whether to scan the whole input before parsing. */
+    bool      compact;    /** Whether to export a compact copy of the tree. */
+    cc_emit_t emit;       /** What to export the tree as. */
+} cc_driver_options_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Exports the tree of a context, or its compact version, to an output.
+ * Trees are never printed with `exporta` this way, `cc_emit_default` is
+ * taken as `cc_emit_dot`.
+ *
+ * @param output where the tree goes.
+ * @param context the compilation, whose tree is freed once made compact.
+ * @param compact whether to make a compact tree out of it first, which
+ *                binary files are always written from.
+ * @param emit what to export it as.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_write_ast(
+    cc_output_t*  output,
+    cc_context_t* context,
+    bool          compact,
+    cc_emit_t     emit);
+
+/**
+ * Exports a compact tree to an output, just like `cc_write_ast`.
+ *
+ * @param output where the tree goes.
+ * @param ast the compact tree.
+ * @param emit what to export it as, anything but JSON, which needs the
+ *             symbols of the tree.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_write_compact_ast(
+    cc_output_t*            output,
+    cc_compact_ast_t const* ast,
+    cc_emit_t               emit);
+
+/**
+ * Compiles an input with the given context and exports its tree. The
+ * context reports errors to its own diagnostics stream and is left as
+ * the compilation ended, to be freed or reset.
+ *
+ * @param context the context, fresh or reset.
+ * @param input the input.
+ * @param output where the tree goes.
+ * @param options how to compile it.
+ *
+ * @return the result of parsing, or -1 if the input couldn't be scanned.
+ */
+int cc_compile_context(
+    cc_context_t*              context,
+    cc_input_t*                input,
+    cc_output_t*               output,
+    cc_driver_options_t const* options);
+
+/**
+ * Compiles a single input and exports its tree.
+ *
+ * @param path the path of the source file.
+ * @param output where the tree goes.
+ * @param diagnostics where errors are reported.
+ * @param options how to compile it.
+ *
+ * @return the result of parsing, or -1 if the input couldn't be read.
+ */
+int cc_compile_input(
+    char const*                path,
+    cc_output_t*               output,
+    FILE*                      diagnostics,
+    cc_driver_options_t const* options);
+
+/**
+ * Compiles many inputs on the given number of threads, writing the tree
+ * of each to the standard output and its diagnostics to the standard
+ * error, input by input, in order.
+ *
+ * @param paths the paths of the source files.
+ * @param count how many there are.
+ * @param threads how many to compile at once.
+ * @param options how to compile them.
+ *
+ * @return the result of the first input that didn't compile, as
+ *         `cc_compile_input` tells, or 0 if all of them did.
+ */
+int cc_compile_inputs(
+    char const* const*         paths,
+    uint32_t                   count,
+    uint32_t                   threads,
+    cc_driver_options_t const* options);
+
+#endif /* _PARSER_DRIVER_H_ */
@@ -19,6 +19,7 @@
 #ifndef _PARSER_H_
 #define _PARSER_H_
 
+#include <stdarg.h>
 #include <stdio.h>
 
 #include "lexer/scanner.h"
@@ -28,11 +29,16 @@
  * Prints to stderr a message with interesting information regarding the
  * current context.
  *
+ * @param location where bison thinks the error is, the context knows
+ *                 better.
+ * @param context the compilation.
  * @param s the string you wish to print along with the current context.
  * @param elipse optional objects to format into the error string.
  */
 void yyerror(
-    char const*  s,
+    YYLTYPE*      location,
+    cc_context_t* context,
+    char const*   s,
     /* format */ ...);
 
 #endif /* _PARSER_H_ */
@@ -0,0 +1,118 @@
+/** @file parser/server.h
+ *
+ * @brief A resident compiler, taking requests over a Unix socket.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Compiling a tiny input takes less than starting the process that does
+ * it. The server is started once and then compiles whatever it's sent
+ * over a Unix-domain socket, one connection per input, with a single
+ * context that's reset between inputs rather than freed, so its arenas,
+ * interned names and line index, as well as the buffer the tree is
+ * exported to, are already there for the next one. Requests are served
+ * one at a time, in the order they arrive, so a client that stalls for
+ * longer than `SERVER_TIMEOUT` is hung up on rather than waited for. The
+ * socket is only accessible to the user that started the server.
+ *
+ * A request is a `cc_request_t` followed by the source itself. It's
+ * answered with a `cc_response_t`, followed by the diagnostics and then
+ * the exported tree, in the order they were produced. Trees are exported
+ * just like the driver does it, see "parser/driver.h". Both ends are
+ * expected to be on the same machine, so the records go in its own byte
+ * order.
+ */
+
+#ifndef _PARSER_SERVER_H_
+#define _PARSER_SERVER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "lexer/input.h"
+#include "parser/driver.h"
+
+/* the first bytes of every request */
+#define SERVER_REQUEST_MAGIC "CCRQ"
+
+/* the first bytes of every response */
+#define SERVER_RESPONSE_MAGIC "CCRS"
+
+/* where the server listens if not told otherwise */
+#define DEFAULT_SERVER_PATH "/tmp/etapa.sock"
+
+/* the largest source the server accepts */
+#define MAX_SERVER_INPUT_SIZE ((uint64_t)1 << 30)
+
+/* how long, in seconds, the server waits on a client to send or take
+ * anything before hanging up on it */
+#define SERVER_TIMEOUT ((time_t)5)
+
+/* flags of a request */
+#define SERVER_FAST_LEXER ((uint32_t)1 << 0) /* scan with the hand-written scanner */
+#define SERVER_PRE_LEX    ((uint32_t)1 << 1) /* scan the whole input before parsing */
+#define SERVER_COMPACT    ((uint32_t)1 << 2) /* export a compact copy of the tree */
+#define SERVER_STOP       ((uint32_t)1 << 3) /* stop the server, there's no source */
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    char     magic[4]; /** `SERVER_REQUEST_MAGIC`. */
+    uint32_t flags;    /** How to compile the source. */
+    uint32_t emit;     /** What to export the tree as, a `cc_emit_t`. */
+    uint32_t reserved; /** Always 0. */
+    uint64_t length;   /** How many bytes of source follow. */
+} cc_request_t;
+
+typedef struct {
+    char     magic[4];           /** `SERVER_RESPONSE_MAGIC`. */
+    int32_t  result;             /** What `cc_compile_context` returned. */
+    uint64_t diagnostics_length; /** How many bytes of errors follow. */
+    uint64_t output_length;      /** How many bytes of tree follow the errors. */
+} cc_response_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Serves requests on a Unix socket until asked to stop, either by a
+ * request or by `SIGINT` or `SIGTERM`. A stale socket at the given path
+ * is replaced, and the socket is removed once the server stops.
+ *
+ * @param path the path of the socket.
+ *
+ * @return 0 once stopped, or -1 if the socket couldn't be set up.
+ */
+int cc_serve(char const* path);
+
+/**
+ * Sends an input to a server, and writes what comes back to the standard
+ * output and the standard error.
+ *
+ * @param path the path of the socket of the server.
+ * @param flags how to compile the input.
+ * @param emit what to export its tree as.
+ * @param input the input, or `NULL` when stopping the server.
+ * @param result where to store the result of the compilation.
+ *
+ * @return whether the server could be reached and answered.
+ */
+bool cc_ask_server(
+    char const*       path,
+    uint32_t          flags,
+    cc_emit_t         emit,
+    cc_input_t const* input,
+    int*              result);
+
+#endif /* _PARSER_SERVER_H_ */
@@ -0,0 +1,98 @@
+/** @file parser/stream.h
+ *
+ * @brief Parsing of input that arrives in chunks.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * When the input comes from a pipe or a socket, there's no need to wait
+ * for all of it before compiling. A stream takes the input in chunks, as
+ * they arrive, scans every line that is already complete and pushes its
+ * tokens right away into the parser, so the tree of the context grows a
+ * function at a time while the rest of the input is on its way.
+ *
+ * Flex wants the whole input beforehand, so streams are always scanned
+ * by the hand-written scanner. Everything received is kept, as the
+ * diagnostics may point back into any line of it.
+ */
+
+#ifndef _PARSER_STREAM_H_
+#define _PARSER_STREAM_H_
+
+#include <stddef.h>
+
+#include "parser/context.h"
+#include "utils/memory.h"
+
+/* initial size of the buffer of a stream */
+#define DEFAULT_STREAM_BUFFER_SIZE ((size_t)65536)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    cc_context_t* context;  /** The compilation being fed. */
+    yypstate*     parser;   /** The state of the push parser. */
+    char*         text;     /** Everything received so far, followed by two null characters. */
+    size_t        length;   /** How many characters were received. */
+    size_t        capacity; /** How many characters fit in `text`. */
+    size_t        scanned;  /** Up to where the input was handed to the scanner. */
+    int           status;   /** `YYPUSH_MORE` while parsing, then what `yyparse` would return. */
+} cc_stream_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Creates a stream that feeds the given compilation, which mustn't have
+ * been given an input yet.
+ *
+ * @param context the compilation.
+ *
+ * @return a pointer to the stream, allocated in dynamic memory.
+ */
+cc_stream_t* cc_create_stream(cc_context_t* context);
+
+/**
+ * Appends a chunk to the input of a stream, parsing every line that it
+ * completes. Chunks may be cut anywhere, even in the middle of a token.
+ *
+ * @param stream the stream.
+ * @param chunk the characters received, which are copied.
+ * @param length how many characters were received.
+ *
+ * @return `YYPUSH_MORE` while the parser wants more input, or the final
+ *         result of parsing, as `yyparse` returns it, once it doesn't.
+ */
+int cc_feed_stream(
+    cc_stream_t* stream,
+    char const*  chunk,
+    size_t       length);
+
+/**
+ * Tells a stream that its input is over, parsing whatever is left.
+ *
+ * @param stream the stream.
+ *
+ * @return the result of parsing, as `yyparse` returns it.
+ */
+int cc_finish_stream(cc_stream_t* stream);
+
+/**
+ * Frees a stream along with its copy of the input. The context, and so
+ * the tree, is left alone, but its diagnostics can no longer print lines.
+ *
+ * @param stream the stream, can be `NULL`.
+ */
+void cc_free_stream(cc_stream_t* stream);
+
+#endif /* _PARSER_STREAM_H_ */
@@ -37,12 +37,14 @@
  * The function can receive zero or more locations and, therefore, print
  * their lines and underline correctly.
  *
+ * @param context the compilation whose text the locations refer to.
  * @param error the error class to be returned.
  * @param num_locations number of locations to be read from the elipse.
  * @param elipse locations to print as well.
  */
 
 void cc_semantic_error(
+    cc_context_t*       context,
     cc_error_t          error,
     unsigned int        num_locations,
     /* cc_location_t */ ...);
@@ -18,6 +18,17 @@
  * hash tables.  Therefore, this module  aims to hide away  any possible
  * implementation  details  so  utilization   inside  Bison  actions  is
  * smoother and cleaner.
+ *
+ * There is a single symbol table per compilation, in the style of
+ * LeBlanc and Cook: it maps each name to its innermost binding, and every
+ * binding points to  the one it shadows. Looking  a name up is then just
+ * one probe, no matter how deep the  stack is. Each scope level, in turn,
+ * remembers the  bindings it made, so  closing it only unwinds  those.
+ *
+ * Each scope level owns an arena where its bindings are allocated, so
+ * closing a block releases them in one step. Symbols themselves outlive
+ * their scope, as the AST points to them. Names are all  interned (see
+ * "utils/intern.h"), and so must be the names we query.
  */
 
 #ifndef _SEMANTICS_SCOPE_H_
@@ -28,8 +39,12 @@
 #include "semantics/values.h"
 #include "utils/list.h"
 #include "utils/map.h"
+#include "utils/memory.h"
 #include "utils/stack.h"
 
+#define SCOPE_ARENA_BLOCK_SIZE ((size_t)8192)
+
+
 typedef enum {
     cc_declared_current,
     cc_declared_previous,
@@ -41,72 +56,112 @@ typedef struct {
     cc_symb_t* symbol;
 } cc_query_answer_t;
 
+typedef struct cc_binding_t {
+    char const*          name;     /** The interned name being bound. */
+    cc_symb_t*           symbol;   /** The symbol the name is bound to. */
+    uint32_t             depth;    /** The level of the scope that made it. */
+    struct cc_binding_t* shadowed; /** The outer binding of the same name. */
+    struct cc_binding_t* sibling;  /** The previous binding of the same level. */
+} cc_binding_t;
+
+typedef struct {
+    uint32_t      depth;    /** How many levels are below this one. */
+    cc_binding_t* bindings; /** The bindings made in this level, newest first. */
+    cc_arena_t*   arena;    /** Storage for the bindings. */
+} cc_scope_t;
+
 /**
- * The  scope variable  is global,  as  everything in  Bison is  global.
- * Basically, all code  here is going to interact with  this variable in
- * one way or another.
+ * Each compilation keeps its own scope stack in its context, `scope`, a
+ * stack of `cc_scope_t` with the innermost level on top, next to the
+ * symbol table it unwinds. Every function here works on the stack of the
+ * context it's given, so compilations never see each other's scopes.
  */
-extern cc_stack_t* scope;
-
 /* --------------------------------------------------------------------------- */
 /* Function prototypes: */
 
 /**
- * Initializes the global scope variable.
+ * Initializes the scope stack of a compilation, with its global level and
+ * its symbol table.
  *
- * @returns a pointer to an initialized scope variable in heap memory.
+ * @param context the compilation.
  */
-cc_stack_t* cc_init_global_scope(void);
+void cc_init_global_scope(cc_context_t* context);
 
 /**
  * Pushes a new empty  scope to the stack. In other  words, create a new
- * hash map and push it to the scope stack.
+ * scope level, with a still empty arena, and push it to the scope stack.
+ *
+ * @param context the compilation.
  */
-void cc_push_new_scope(void);
+void cc_push_new_scope(cc_context_t* context);
 
 /**
- * Pops the current scope into oblivion.
+ * Pops the current scope into oblivion,  along with every binding it has
+ * made. Names it shadowed are visible again.
+ *
+ * @param context the compilation.
  */
-void cc_pop_top_scope(void);
+void cc_pop_top_scope(cc_context_t* context);
 
 /**
- * Adds all symbols in the given list to the current global scope.
+ * Pops every scope level still open, the global one included, and frees
+ * the stack itself.
  *
- * @param list the list of pairs between symbols and names to be added.
+ * @param context the compilation.
+ */
+void cc_free_scope(cc_context_t* context);
+
+/**
+ * Adds all symbols in the given list to the current global scope. The
+ * list itself is left untouched, as it may be kept elsewhere (e.g. the
+ * parameters of a function). Room for the whole list is made up front.
  *
- * @see the global variable `scope`.
+ * @param context the compilation.
+ * @param list the list of pairs between symbols and names to be added.
  */
-void cc_add_list_scope(cc_list_t* list);
+void cc_add_list_scope(
+    cc_context_t* context,
+    cc_list_t*    list);
 
 /**
- * Adds the pair name and symbol to the current scope.
+ * Adds the pair name and symbol to the current scope. The pair is freed
+ * in the process.
  *
+ * @param context the compilation.
  * @param pair the pair of types `char*` and `cc_symb_t*`
  */
-void cc_add_pair_scope(cc_symb_pair_t* pair);
+void cc_add_pair_scope(
+    cc_context_t*   context,
+    cc_symb_pair_t* pair);
 
 /**
- * Unwinds  the scope  stack  searching  for the  existance  of a  given
- * identifier  node. In  other words,  we check  to see  if it  has been
- * declared at any point.
+ * Searches  the symbol table for the  existance of a  given identifier
+ * node. In other words, we check to  see if it has been declared at any
+ * point, and if so, whether it was in the current scope.
  *
- * @param name the name of the identifier.
+ * @param context the compilation.
+ * @param name the interned name of the identifier.
  *
  * @return the  query answer, containing  where it was declared  and the
  *         symbol itself.
  */
-cc_query_answer_t cc_check_id_existence_scope(char const* name);
+cc_query_answer_t cc_check_id_existence_scope(
+    cc_context_t* context,
+    char const*   name);
 
 /**
- * Checks the  usage of the  given name in  the current scope  stack and
+ * Checks the usage of the given identifier in the current scope stack and
  * compares it to the expected kind  of declaration that the name should
- * be bound to.
+ * be bound to. The symbol found is stored in the identifier itself, so no
+ * later pass has to look it up again.
  *
- * @param name the name of the identifier.
+ * @param context the compilation.
+ * @param id the lexic value of the identifier.
  * @param kind the type of declaration (variable, array or function).
  */
 void cc_check_name_usage_scope(
-    char const*    name,
-    cc_symb_kind_t kind);
+    cc_context_t*     context,
+    cc_lexic_value_t* id,
+    cc_symb_kind_t    kind);
 
 #endif /* _SEMANTICS_SCOPE_H_ */
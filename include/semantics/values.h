@@ -45,7 +45,7 @@ typedef union {
     cc_lexic_value_t* temp_value;
 } cc_symb_opt;
 
-typedef struct {
+typedef struct cc_symb_s {
     cc_location_t location;
     cc_symb_kind_t kind;
     cc_type_t type;
@@ -56,56 +56,49 @@ typedef struct {
 
 typedef struct {
     cc_symb_t* symbol;
-    char* name;
+    char const* name; /* interned, so never freed with the pair */
 } cc_symb_pair_t;
 
 /* --------------------------------------------------------------------------- */
 /* Function prototypes: */
 
 /**
- * Creates and initializes a new symbol in dynamic memory.
+ * Creates and initializes  a new symbol in the symbol  storage. Symbols
+ * outlive the scope that declared them,  as identifiers in the AST keep
+ * pointing to them, so they're only released by `cc_free_symbols`.
  *
+ * @param context the compilation the symbol belongs to.
  * @param location the location (line and column) of the symbol.
  * @param kind whether its a variable, an array or a function.
  *
- * @return a new symbol allocated in the heap.
+ * @return a new symbol allocated in the symbol storage.
  *
  * @see the header "lexer/location.h".
  */
 cc_symb_t* cc_create_symbol(
+    cc_context_t*  context,
     cc_location_t  location,
     cc_symb_kind_t kind);
 
-/**
- * Frees  a heap-allocated  symbol type  given  a pointer  to it,  while
- * taking in consideration its kind.
- *
- * @param symbol the pointer to the symbol.
- */
-void cc_free_symbol(cc_symb_t* symbol);
-
-/**
- * A void wrapper to the function above.
- */
-void cc_free_symbol_void(void* pointer);
-
 /**
  * Given a valid  lexic value of a identifier, create  a name and symbol
- * pair. After operation, the given `lexic_value` pointer is invalid, as
- * it is free'd in the process.
+ * pair. Unless it's a function, the given `lexic_value` isn't referenced
+ * anymore after the operation.
  *
+ * @param context the compilation the symbol belongs to.
  * @param lexic_value a lexic value given by the lexer.
  * @param kind whether its a variable, an array or a function.
  *
  * @return a `cc_symb_t` and `char*` pair.
  */
 cc_symb_pair_t* cc_create_symbol_pair(
+    cc_context_t*     context,
     cc_lexic_value_t* lexic_value,
     cc_symb_kind_t    kind);
 
 /**
- * Frees a  heap-allocated symbol-name pair.  Does not free  the symbol,
- * but only the name.
+ * Frees a  heap-allocated symbol-name pair.  Does not free  the symbol
+ * nor the name, only the pair itself.
  *
  * @param pair the pointer to the pair.
  */
@@ -153,13 +146,16 @@ void cc_init_array_symbol(
 
 /**
  * Initializes a symbol of a function, given an already existing symbol.
+ * The list of parameters is freed along with the symbols.
  *
+ * @param context the compilation the symbol belongs to.
  * @param symbol the symbol to add info to.
  * @param names the names of the parameters, to be used as keys.
  */
 void cc_init_func_symbol(
-    cc_symb_t* symbol,
-    cc_list_t* parameters);
+    cc_context_t* context,
+    cc_symb_t*    symbol,
+    cc_list_t*    parameters);
 
 /**
  * Initializes a symbol of a string, given an already existing symbol.
@@ -183,4 +179,20 @@ bool cc_check_kind_symbol(
     cc_symb_t*       symbol,
     cc_symb_kind_t   kind);
 
+/**
+ * Frees every symbol of a compilation.  As all of them are carved from the
+ * same arena, they're all released at once.
+ *
+ * @param context the compilation the symbols belong to.
+ */
+void cc_free_symbols(cc_context_t* context);
+
+/**
+ * Frees every symbol of a compilation, as `cc_free_symbols`, but keeps
+ * the storage they were carved from for the next one.
+ *
+ * @param context the compilation the symbols belong to.
+ */
+void cc_reset_symbols(cc_context_t* context);
+
 #endif /* _SEMANTICS_VALUES_H_ */
@@ -0,0 +1,78 @@
+/** @file utils/intern.h
+ *
+ * @brief A global pool of interned strings.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Every spelling given to the pool is  stored exactly once, so two interned
+ * strings are equal if and only if  their pointers are equal. The lexer,
+ * the AST and the symbol tables of a compilation all share the same pool,
+ * which means that identifiers are never duplicated nor compared with
+ * `strcmp`.
+ */
+
+#ifndef _UTILS_INTERN_H_
+#define _UTILS_INTERN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "utils/debug.h"
+#include "utils/memory.h"
+
+#define DEFAULT_INTERN_POOL_SIZE ((uint32_t)1024)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    char const* string; /** The interned string, `NULL` if the slot is free. */
+    uint32_t    hash;   /** The hash of the string, so we never recompute it. */
+    uint32_t    length; /** The length of the string. */
+} cc_intern_slot_t;
+
+typedef struct {
+    uint32_t          size;   /** How many slots there are, always a power of two. */
+    uint32_t          count;  /** How many slots are occupied. */
+    cc_intern_slot_t* slots;  /** The open addressing table itself. */
+    cc_arena_t*       arena;  /** Where the strings live. */
+} cc_intern_pool_t;
+
+/* --------------------------------------------------------------------------- */
+/* Global function prototypes: */
+
+/**
+ * Retrieves the unique copy of the first `length` characters of `text`,
+ * adding it to the pool if it's the first time we see it.
+ *
+ * @param pool the pool, zeroed before its first use.
+ * @param text the string to intern, it doesn't need to be null terminated.
+ * @param length how many characters of `text` to consider.
+ *
+ * @return the interned, null terminated, string.
+ */
+char const* cc_intern_string(
+    cc_intern_pool_t* pool,
+    char const*       text,
+    size_t            length);
+
+/**
+ * Frees the  pool and every  string in it.  Any pointer given  by it is
+ * invalid afterwards, and the pool is left empty.
+ *
+ * @param pool the pool.
+ */
+void cc_free_interned_strings(cc_intern_pool_t* pool);
+
+#endif /* _UTILS_INTERN_H_ */
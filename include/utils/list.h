@@ -102,6 +102,13 @@ void cc_free_list_nodes(
  */
 void cc_free_list(cc_list_t* list);
 
+/**
+ * Frees a list, given as a pointer to void, for lists of lists.
+ *
+ * @param list the list you wish to free.
+ */
+void cc_free_list_void(void* list);
+
 /**
  * Inserts an item at the end of the list.
  *
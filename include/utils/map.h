@@ -15,6 +15,13 @@
  * @section DESCRIPTION
  *
  * Contains the implementation of a hash table, all bateries included.
+ *
+ * The table uses  open addressing with Robin Hood linear  probing: a key
+ * being inserted  takes the slot  of any key that  is closer to  its own
+ * home slot, which keeps probe sequences short even under high load. Key
+ * and value live inline in the slot array, which doubles in size when it
+ * gets too crowded. Deletions shift the following keys back, so there is
+ * no need for tombstones.
  */
 
 #ifndef _UTILS_MAP_H_
@@ -29,32 +36,35 @@
 #include "utils/debug.h"
 #include "utils/memory.h"
 
-#define DEFAULT_MAP_SIZE ((uint32_t)521)
+/* initial capacity of a map, it grows as needed */
+#define DEFAULT_MAP_SIZE ((uint32_t)32)
 
 /* --------------------------------------------------------------------------- */
 /* Type definitions: */
 
-typedef struct cc_map_node_s {
-    struct cc_map_node_s* next;
-    void*                 value;
-    char*                 key;
-} cc_map_node_t;
+typedef struct {
+    char const* key;   /** The key, or `NULL` if the slot is empty. */
+    void*       value; /** The value the key maps to. */
+    uint32_t    hash;  /** The full hash of the key, so we never recompute it. */
+} cc_map_slot_t;
 
 typedef struct {
-    uint32_t        size;       /** The size of this map. */
+    uint32_t        size;       /** The size of this map, always a power of two. */
     uint32_t        count;      /** How many elements are occupied in this map. */
-    cc_map_node_t** items;      /** Pointer to the elements of the map. */
+    cc_map_slot_t*  items;      /** The slots of the map, stored inline. */
     void (*custom_free)(void*); /** Cleaning function to the elements of the map */
+    cc_arena_t*     arena;      /** Where the map lives, or `NULL` if in the heap. */
+    bool            interned_keys; /** Whether keys are compared by address. */
 } cc_map_t;
 
 /* --------------------------------------------------------------------------- */
 /* Global function prototypes: */
 
 /**
- * Creates the  map structure in dynamic  memory with the given  size in
- * the parameter `size`.
+ * Creates the  map structure in dynamic memory  with an initial capacity
+ * of at least `size` elements.
  *
- * @param size the size of the map.
+ * @param size the initial size of the map.
  * @param custom_free the custom free function that will be used to free
  *                    the values when necessary.
  *
@@ -65,12 +75,43 @@ cc_map_t* cc_create_map(
     void   (*custom_free)(void*));
 
 /**
- * Frees a hash map.
+ * Creates the map structure inside  the given arena. Every entry and key
+ * inserted afterwards is also allocated in  it, so the whole map goes away
+ * with the arena. Values are never freed by the map.
+ *
+ * If `interned_keys` is set, keys must come from `cc_intern_string`: they
+ * are neither copied nor compared by content, only by address.
+ *
+ * @param size the initial size of the map.
+ * @param arena the arena that owns the map.
+ * @param interned_keys whether keys are interned strings.
+ *
+ * @return a pointer to the just created map.
+ */
+cc_map_t* cc_create_arena_map(
+    uint32_t    size,
+    cc_arena_t* arena,
+    bool        interned_keys);
+
+/**
+ * Frees a hash map. Does nothing if the map lives in an arena.
  *
  * @param pointer a pointer to the map you wish to free.
  */
 void cc_free_map(cc_map_t* pointer);
 
+/**
+ * Grows the map, if needed, so that it holds `count` elements in total
+ * without having to grow again. Useful before inserting a known number
+ * of keys at once.
+ *
+ * @param map the map to grow.
+ * @param count how many elements the map should fit.
+ */
+void cc_reserve_map(
+    cc_map_t* map,
+    uint32_t  count);
+
 /**
  * Inserts an element to the given hash map.
  *
@@ -78,13 +119,26 @@ void cc_free_map(cc_map_t* pointer);
  * @param key the key to use.
  * @param value the value that the given key should map to.
  *
- * @return a boolean indicating success.
+ * @return a boolean indicating success, i.e. whether the key was new.
  */
 bool cc_insert_entry_map(
     cc_map_t*   map,
     char const* key,
     void*       value);
 
+/**
+ * Binds a key to the given value, whether the key is already in the map
+ * or not. A previous value is freed as any other value of the map.
+ *
+ * @param map the hash map we'll insert into.
+ * @param key the key to use.
+ * @param value the value that the given key should map to.
+ */
+void cc_set_entry_map(
+    cc_map_t*   map,
+    char const* key,
+    void*       value);
+
 /**
  * Indexes the  map for  the given  key. If the  key doesn't  exist, the
  * return value will be `NULL`.
@@ -99,7 +153,7 @@ void* cc_get_entry_map(
     char const* key);
 
 /**
- * Deletes a map node from the given character key.
+ * Deletes a map entry from the given character key.
  *
  * @param map the map to delete from.
  * @param key the key we're looking to delete.
@@ -14,48 +14,210 @@
  *
  * @section DESCRIPTION
  *
- * Wrappers over common dynamic memory management function.
+ * Wrappers over  common dynamic memory management  function, along with
+ * a simple bump-pointer arena for  objects that all share the same (long)
+ * lifetime and, therefore, can be released at once.
+ *
+ * Every allocation  is tagged with  a category and accounted  for, so we
+ * can tell which part of the compiler owns the heap. Memory given by the
+ * `cc_try_*` family must be released with `cc_free`.
  */
 
 #ifndef _UTILS_MEMORY_H_
 #define _UTILS_MEMORY_H_
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "utils/debug.h"
 
+#define DEFAULT_ARENA_BLOCK_SIZE ((size_t)65536)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef enum {
+    cc_mem_misc,
+    cc_mem_lexic,
+    cc_mem_ast,
+    cc_mem_string,
+    cc_mem_symbol,
+    cc_mem_map,
+    cc_mem_scope,
+    cc_mem_stack,
+    cc_mem_list,
+    cc_mem_text,
+    cc_mem_token,
+    cc_mem_arena,
+    cc_mem_num_categories
+} cc_mem_category_t;
+
+typedef struct {
+    size_t allocations; /** How many allocations were made. */
+    size_t bytes;       /** How many bytes were requested in total. */
+    size_t live;        /** How many bytes are currently in use. */
+    size_t peak;        /** The greatest value `live` ever had. */
+} cc_mem_stats_t;
+
+typedef struct cc_arena_block_s {
+    struct cc_arena_block_s* next; /** The block filled before this one. */
+    size_t                   size; /** How many bytes this block can hold. */
+    size_t                   used; /** How many bytes were already handed out. */
+    max_align_t              data[]; /** The storage itself, suitably aligned. */
+} cc_arena_block_t;
+
+typedef struct {
+    cc_arena_block_t* current;    /** The block we're currently bumping into. */
+    size_t            block_size; /** The default size of each new block. */
+    size_t            carved[cc_mem_num_categories]; /** Bytes handed out per category. */
+} cc_arena_t;
+
+/* --------------------------------------------------------------------------- */
+/* Global function prototypes: */
+
 /**
  * Tries to realloc the memory region, doing all required safety checks.
  *
- * @param pointer the existing memory block allocated with malloc, calloc or realloc.
+ * @param pointer the existing memory block allocated with the `cc_try_*` family.
  * @param new_size the desired new size.
+ * @param category what the memory is used for, only read if `pointer` is `NULL`.
  *
  * @return the pointer to the reallocated memory block.
  */
 void* cc_try_realloc(
-    void*  pointer,
-    size_t new_size);
+    void*             pointer,
+    size_t            new_size,
+    cc_mem_category_t category);
 
 /**
  * Tries to malloc the memory region, doing all required safety checks.
  *
  * @param desired_size the desired new size.
+ * @param category what the memory is used for.
  *
  * @return the pointer to the memory block.
  */
-void* cc_try_malloc(size_t desired_size);
+void* cc_try_malloc(
+    size_t            desired_size,
+    cc_mem_category_t category);
 
 /**
  * Tries to calloc a memory region, doing all required safety checks.
  *
  * @param quantity the number of blocks.
  * @param size the desired size of each block.
+ * @param category what the memory is used for.
  *
  * @return the pointer to the memory block.
  */
 void* cc_try_calloc(
-    size_t quantity,
-    size_t size);
+    size_t            quantity,
+    size_t            size,
+    cc_mem_category_t category);
+
+/**
+ * Duplicates the first `length` characters of `text` into a new string,
+ * accounted as `cc_mem_string`.
+ *
+ * @param text the original string.
+ * @param length how many characters to copy.
+ *
+ * @return the null terminated copy, to be released with `cc_free`.
+ */
+char* cc_try_strndup(
+    char const* text,
+    size_t      length);
+
+/**
+ * Frees a memory block allocated with the `cc_try_*` family.
+ *
+ * @param pointer the memory block, can be `NULL`.
+ */
+void cc_free(void* pointer);
+
+/**
+ * Creates an empty arena in dynamic memory. No block is allocated until
+ * the first request.
+ *
+ * @param block_size the size of each block, in bytes.
+ *
+ * @return a pointer to the just created arena.
+ */
+cc_arena_t* cc_create_arena(size_t block_size);
+
+/**
+ * Frees an arena and every single object ever allocated from it.
+ *
+ * @param arena the arena you wish to free.
+ */
+void cc_free_arena(cc_arena_t* arena);
+
+/**
+ * Frees every object ever allocated from an arena, but keeps its newest
+ * regular block around to be allocated from again, so an arena used over
+ * and over doesn't go back to the heap each time.
+ *
+ * @param arena the arena, can be `NULL`.
+ */
+void cc_reset_arena(cc_arena_t* arena);
+
+/**
+ * Allocates `size` bytes from  the given arena. The returned region is
+ * aligned to `max_align_t` and can't be freed individually.
+ *
+ * @param arena the arena to allocate from.
+ * @param size the desired size.
+ * @param category what the memory is used for.
+ *
+ * @return the pointer to the memory block.
+ */
+void* cc_alloc_arena(
+    cc_arena_t*       arena,
+    size_t            size,
+    cc_mem_category_t category);
+
+/**
+ * Copies the  first `length`  characters of  `text` to  a new  string
+ * allocated in the given arena, accounted as `cc_mem_string`.
+ *
+ * @param arena the arena to allocate from.
+ * @param text the original string.
+ * @param length how many characters to copy.
+ *
+ * @return the null terminated copy.
+ */
+char* cc_strndup_arena(
+    cc_arena_t* arena,
+    char const* text,
+    size_t      length);
+
+/**
+ * Retrieves the statistics of a given category. Objects carved from an
+ * arena count towards their own category as well as `cc_mem_arena`.
+ *
+ * @param category the category we're interested in.
+ *
+ * @return a copy of the statistics.
+ */
+cc_mem_stats_t cc_get_memory_stats(cc_mem_category_t category);
+
+/**
+ * Retrieves the statistics of the heap as a whole,  that is, of every
+ * block actually requested to the system allocator.
+ *
+ * @return a copy of the statistics.
+ */
+cc_mem_stats_t cc_get_heap_stats(void);
+
+/**
+ * Prints a table with the statistics of every category and of the heap
+ * as a whole.
+ *
+ * @param stream where to print to.
+ */
+void cc_print_memory_report(FILE* restrict stream);
 
 #endif /* _UTILS_MEMORY_H_ */
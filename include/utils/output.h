@@ -0,0 +1,113 @@
+/** @file utils/output.h
+ *
+ * @brief Buffered output straight to a file descriptor.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the  terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Exporters produce a lot of small pieces of text, which go through stdio
+ * slowly. An output gathers them in a large buffer instead, formatting
+ * numbers by hand, and hands the buffer to `write` only when it's full or
+ * flushed. The buffer is kept, so an output may be used over and over.
+ *
+ * Once writing fails the output is marked as such and whatever comes
+ * next is dropped, so callers only need to check when flushing.
+ *
+ * An output to `NO_OUTPUT_FD` keeps everything in memory instead, its
+ * buffer growing as needed, so it can be written somewhere else later.
+ */
+
+#ifndef _UTILS_OUTPUT_H_
+#define _UTILS_OUTPUT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils/memory.h"
+
+/* size of the buffer of an output */
+#define DEFAULT_OUTPUT_BUFFER_SIZE ((size_t)1 << 20)
+
+/* initial size of the buffer of an output kept in memory */
+#define DEFAULT_MEMORY_OUTPUT_SIZE ((size_t)4096)
+
+/* the file descriptor of outputs kept in memory */
+#define NO_OUTPUT_FD (-1)
+
+/* --------------------------------------------------------------------------- */
+/* Type definitions: */
+
+typedef struct {
+    int    fd;       /** Where the output goes. */
+    bool   failed;   /** Whether writing failed. */
+    char*  buffer;   /** The output not yet written. */
+    size_t length;   /** How many characters are in the buffer. */
+    size_t capacity; /** How many characters fit in the buffer. */
+} cc_output_t;
+
+/* --------------------------------------------------------------------------- */
+/* Function prototypes: */
+
+/**
+ * Prepares an output to the given file descriptor, which is left open.
+ *
+ * @param output the output.
+ * @param fd the file descriptor, or `NO_OUTPUT_FD` to keep the output in
+ *           memory.
+ */
+void cc_init_output(
+    cc_output_t* output,
+    int          fd);
+
+/**
+ * Appends text to an output, flushing it first if the text doesn't fit.
+ *
+ * @param output the output.
+ * @param text the text.
+ * @param length how many characters of text there are.
+ */
+void cc_put_output(
+    cc_output_t* output,
+    char const*  text,
+    size_t       length);
+
+/**
+ * Appends a number in decimal to an output.
+ *
+ * @param output the output.
+ * @param number the absolute value of the number.
+ * @param negative whether it's to be preceded by a minus sign.
+ */
+void cc_put_output_number(
+    cc_output_t* output,
+    uint32_t     number,
+    bool         negative);
+
+/**
+ * Writes out whatever is left in the buffer of an output. Does nothing to
+ * outputs kept in memory.
+ *
+ * @param output the output.
+ *
+ * @return whether everything was written so far.
+ */
+bool cc_flush_output(cc_output_t* output);
+
+/**
+ * Frees the buffer of an output, without flushing it.
+ *
+ * @param output the output.
+ */
+void cc_free_output(cc_output_t* output);
+
+#endif /* _UTILS_OUTPUT_H_ */
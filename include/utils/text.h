@@ -22,6 +22,7 @@
 #define _UTILS_TEXT_H_
 
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -45,16 +46,33 @@ char* cc_text_convert_escapes(
     char const* input,
     size_t      limit);
 
+/**
+ * Converts the  explicit escape codes of  the first `limit`  characters
+ * of `string`  into their respective  escape code characters,  in place.
+ * The result is null terminated, so `string` must hold at least `limit +
+ * 1` characters.
+ *
+ * @param string the string to convert.
+ * @param limit limit of the input character array.
+ *
+ * @return the given string, now converted.
+ */
+char* cc_text_unescape(
+    char*  string,
+    size_t limit);
+
 /**
  * Prints a string that underlines a given starting point and range.
  *
  * @param size desired final size of the string.
  * @param start the starting column.
  * @param end the ending column.
+ * @param stream where to print it.
  */
 void cc_text_underline(
     size_t   size,
     uint16_t start,
-    uint16_t end);
+    uint16_t end,
+    FILE*    stream);
 
 #endif /* _UTILS_TEXT_H_ */
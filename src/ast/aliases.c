@@ -22,8 +22,7 @@ void exporta(void* raiz)
 
 void libera(void* raiz)
 {
-    cc_free_ast((cc_ast_t*)raiz);
-    cc_free_list(yytextbuf);
+    (void)raiz; /* the whole tree goes away with its context */
 
     return;
 }
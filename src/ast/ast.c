@@ -12,143 +12,208 @@
  */
 
 #include "ast/ast.h"
+#include "parser/context.h"
 
-/* declaration and definition of `ast_g` global */
-cc_ast_t* ast_g = NULL;
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Allocates `size` bytes in the AST arena, creating it if necessary.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param size the desired size.
+ * @param category what the memory is used for.
+ *
+ * @return the pointer to the memory block.
+ */
+static inline void* cc_alloc_ast_storage(
+    cc_context_t*     context,
+    size_t            size,
+    cc_mem_category_t category);
+
+/**
+ * Creates a new AST node in the AST storage, with its children right
+ * after it. Only the children up to the first `NULL` one are kept.
+ *
+ * @param context the compilation the tree belongs to.
+ * @param content a pointer to the lexic value you wish to assign to the node.
+ * @param arity how many children were given.
+ * @param children the children.
+ *
+ * @return the address of the created `cc_ast_t`.
+ */
+static cc_ast_t* cc_create_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    uint8_t           arity,
+    cc_ast_t* const   children[]);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void* cc_alloc_ast_storage(
+    cc_context_t*     context,
+    size_t            size,
+    cc_mem_category_t category)
+{
+    if (context->ast_arena == NULL)
+        context->ast_arena = cc_create_arena(DEFAULT_ARENA_BLOCK_SIZE);
+
+    return cc_alloc_arena(context->ast_arena, size, category);
+}
+
+char* cc_create_ast_string(
+    cc_context_t* context,
+    char const*   text,
+    size_t        length)
+{
+    if (context->ast_arena == NULL)
+        context->ast_arena = cc_create_arena(DEFAULT_ARENA_BLOCK_SIZE);
+
+    return cc_strndup_arena(context->ast_arena, text, length);
+}
 
 cc_lexic_value_t* cc_create_lexic_value(
+    cc_context_t*       context,
     cc_node_data_t      data,
     cc_node_data_kind_t kind,
     cc_type_t           type,
     cc_location_t       loc)
 {
-    cc_lexic_value_t* pointer = (cc_lexic_value_t*)cc_try_malloc(sizeof(cc_lexic_value_t));
+    cc_lexic_value_t* pointer = (cc_lexic_value_t*)cc_alloc_ast_storage(context, sizeof(cc_lexic_value_t), cc_mem_lexic);
 
     pointer->data     = data;
     pointer->location = loc;
     pointer->kind     = kind;
     pointer->type     = type;
+    pointer->symbol   = NULL;
 
     return pointer;
 }
 
 cc_ast_t* cc_create_ast_node(
+    cc_context_t*     context,
     cc_lexic_value_t* content,
-    cc_ast_t*         next,
-    ...                   )
+    uint8_t           arity,
+    cc_ast_t* const   children[])
 {
-    va_list ap, aux;
-    va_start(aux, next);
-    va_copy(ap, aux);
-
-    uint8_t param_count = 0;
-
-    while (va_arg(aux, cc_ast_t*) != NULL)
-        param_count++;
+    uint8_t count = 0;
 
-    va_end(aux); /* free the aux va_list */
+    while (count < arity && children[count] != NULL)
+        count++;
 
-    cc_ast_t* pointer = (cc_ast_t*)cc_try_malloc(sizeof(cc_ast_t));
+    cc_ast_t* pointer = (cc_ast_t*)cc_alloc_ast_storage(context, sizeof(cc_ast_t) + count * sizeof(cc_ast_t*), cc_mem_ast);
 
     pointer->content      = content;
-    pointer->num_children = param_count;
+    pointer->next         = NULL;
+    pointer->num_children = count;
 
-    if (param_count > 0) {
-        cc_ast_t** children = (cc_ast_t**)cc_try_malloc(param_count * sizeof(cc_ast_t*));
+    for (uint8_t i = 0; i < count; i++)
+        pointer->children[i] = children[i];
 
-        for (uint8_t i = 0; i < param_count; i++)
-            children[i] = va_arg(ap, cc_ast_t*);
-
-        pointer->children = children;
-    } else {
-        pointer->children = NULL;
-    }
+    return pointer;
+}
 
-    pointer->next = next;
+cc_ast_t* cc_create_leaf_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content)
+{
+    return cc_create_ast_node(context, content, 0, NULL);
+}
 
-    va_end(ap); /* free the main va_list */
+cc_ast_t* cc_create_unary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first)
+{
+    cc_ast_t* const children[] = { first };
 
-    return pointer;
+    return cc_create_ast_node(context, content, 1, children);
 }
 
-cc_ast_t* cc_set_next_ast_node(
-    cc_ast_t* first,
-    cc_ast_t* second)
+cc_ast_t* cc_create_binary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first,
+    cc_ast_t*         second)
 {
-    if (first == NULL)
-        return second;
+    cc_ast_t* const children[] = { first, second };
 
-    if (first->next == NULL) {
-        first->next = second;
-    } else {
-        while (first->next != NULL)
-            first = first->next;
+    return cc_create_ast_node(context, content, 2, children);
+}
 
-        first->next = second;
-    }
+cc_ast_t* cc_create_ternary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first,
+    cc_ast_t*         second,
+    cc_ast_t*         third)
+{
+    cc_ast_t* const children[] = { first, second, third };
 
-    return first;
+    return cc_create_ast_node(context, content, 3, children);
 }
 
-cc_ast_t* cc_get_nth_child_node(
-    cc_ast_t* parent,
-    uint8_t   ordinal)
+cc_ast_t* cc_create_quaternary_ast_node(
+    cc_context_t*     context,
+    cc_lexic_value_t* content,
+    cc_ast_t*         first,
+    cc_ast_t*         second,
+    cc_ast_t*         third,
+    cc_ast_t*         fourth)
 {
-    if (ordinal > parent->num_children || ordinal == 0)
-        return NULL;
+    cc_ast_t* const children[] = { first, second, third, fourth };
 
-    return parent->children[ordinal - 1];
+    return cc_create_ast_node(context, content, 4, children);
 }
 
-void cc_free_lexic_value(cc_lexic_value_t* value)
+cc_ast_chain_t cc_create_ast_chain(cc_ast_t* first)
 {
-    if (value == NULL)
-        return;
+    cc_ast_chain_t chain = { NULL, NULL };
 
-    switch (value->kind) {
-    case cc_call:
-    case cc_func:
-    case cc_id:
-        free(value->data.id);
-        break;
-    case cc_lit:
-        if (value->type == cc_type_string)
-            free(value->data.lit.string);
-        break;
-    default:
-        break;
-    }
+    return cc_append_ast_chain(chain, first);
+}
 
-    free(value);
+cc_ast_chain_t cc_append_ast_chain(
+    cc_ast_chain_t chain,
+    cc_ast_t*      node)
+{
+    cc_ast_chain_t single = { node, node };
 
-    return;
+    return cc_concat_ast_chain(chain, single);
 }
 
-void cc_free_ast_node(cc_ast_t* node)
+cc_ast_chain_t cc_concat_ast_chain(
+    cc_ast_chain_t first,
+    cc_ast_chain_t second)
 {
-    if (node == NULL)
-        return;
+    if (second.head == NULL)
+        return first;
 
-    cc_free_lexic_value(node->content);
+    if (first.head == NULL)
+        return second;
 
-    free(node->children);
-    free(node);
+    first.tail->next = second.head;
+    first.tail       = second.tail;
 
-    return;
+    return first;
 }
 
-void cc_free_ast(cc_ast_t* ast)
+cc_ast_t* cc_get_nth_child_node(
+    cc_ast_t* parent,
+    uint8_t   ordinal)
 {
-    if (ast == NULL)
-        return;
-
-    for (uint8_t i = 0; i < ast->num_children; i++)
-        cc_free_ast(ast->children[i]);
+    if (ordinal > parent->num_children || ordinal == 0)
+        return NULL;
 
-    if (ast->next != NULL)
-        cc_free_ast(ast->next);
+    return parent->children[ordinal - 1];
+}
 
-    cc_free_ast_node(ast);
+void cc_free_ast(cc_context_t* context)
+{
+    cc_free_arena(context->ast_arena);
+    context->ast_arena = NULL;
+    context->ast       = NULL;
 
     return;
 }
@@ -169,10 +234,11 @@ void cc_invert_number_literal(
     return;
 }
 
-void cc_update_global_ast(cc_ast_t* new_value)
+void cc_update_global_ast(
+    cc_context_t* context,
+    cc_ast_t*     new_value)
 {
-    ast_g = new_value;
-    arvore = (void*)new_value;
+    context->ast = new_value;
 
     return;
 }
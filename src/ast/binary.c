@@ -0,0 +1,357 @@
+/** @file ast/binary.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <string.h>
+
+#include "ast/binary.h"
+
+/* the records are written and read as they are in memory */
+_Static_assert(sizeof(cc_binary_header_t) == 32, "binary tree header must take 32 bytes");
+_Static_assert(sizeof(cc_binary_node_t) == 32, "binary tree node must take 32 bytes");
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/* the string section of a file being written */
+typedef struct {
+    char*     text;     /** The strings, one after the other. */
+    size_t    length;   /** How many bytes of strings there are. */
+    size_t    capacity; /** How many bytes fit in `text`. */
+    cc_map_t* offsets;  /** The offset of each string, plus one. */
+} cc_binary_strings_t;
+
+/**
+ * Tells whether nodes of the given kind and type hold a string.
+ *
+ * @param kind the kind of the node.
+ * @param type its type.
+ *
+ * @return whether it holds a string.
+ */
+static bool cc_has_binary_string(
+    cc_node_data_kind_t kind,
+    cc_type_t           type);
+
+/**
+ * Gets the offset of a string in the section, appending it if it's new.
+ *
+ * @param strings the string section.
+ * @param string the string.
+ *
+ * @return its offset.
+ */
+static uint64_t cc_add_binary_string(
+    cc_binary_strings_t* strings,
+    char const*          string);
+
+/**
+ * Gets how a compact node is stored in a file.
+ *
+ * @param strings the string section, holding the string of the node
+ *                already, if it has one.
+ * @param node the node.
+ *
+ * @return the record of the node.
+ */
+static cc_binary_node_t cc_make_binary_node(
+    cc_binary_strings_t*     strings,
+    cc_compact_node_t const* node);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+bool cc_has_binary_string(
+    cc_node_data_kind_t kind,
+    cc_type_t           type)
+{
+    return kind == cc_id || kind == cc_func || kind == cc_call || (kind == cc_lit && type == cc_type_string);
+}
+
+uint64_t cc_add_binary_string(
+    cc_binary_strings_t* strings,
+    char const*          string)
+{
+    uintptr_t known = (uintptr_t)cc_get_entry_map(strings->offsets, string);
+
+    if (known != 0)
+        return known - 1;
+
+    size_t   length = strlen(string) + 1;
+    uint64_t offset = strings->length;
+
+    if (strings->capacity - strings->length < length) {
+        while (strings->capacity - strings->length < length)
+            strings->capacity *= 2;
+
+        strings->text = (char*)cc_try_realloc(strings->text, strings->capacity, cc_mem_string);
+    }
+
+    memcpy(strings->text + strings->length, string, length);
+    strings->length += length;
+
+    cc_insert_entry_map(strings->offsets, string, (void*)(uintptr_t)(offset + 1));
+
+    return offset;
+}
+
+cc_binary_node_t cc_make_binary_node(
+    cc_binary_strings_t*     strings,
+    cc_compact_node_t const* node)
+{
+    cc_binary_node_t record = {
+        .line         = node->location.line,
+        .column       = node->location.column,
+        .length       = node->location.length,
+        .kind         = node->kind,
+        .type         = node->type,
+        .num_children = node->num_children,
+        .children     = node->children,
+        .next         = node->next,
+    };
+
+    switch ((cc_node_data_kind_t)node->kind) {
+    case cc_id:
+    case cc_func:
+    case cc_call:
+        record.value = cc_add_binary_string(strings, node->data.id);
+        break;
+    case cc_expr:
+        record.value = (uint64_t)node->data.expr;
+        break;
+    case cc_cmd:
+        record.value = (uint64_t)node->data.cmd;
+        break;
+    case cc_lit: {
+        switch ((cc_type_t)node->type) {
+        case cc_type_string:
+            record.value = cc_add_binary_string(strings, node->data.lit.string);
+            break;
+        case cc_type_float:
+            memcpy(&record.value, &node->data.lit.floating, sizeof(double));
+            break;
+        case cc_type_int:
+            record.value = (uint32_t)node->data.lit.integer;
+            break;
+        case cc_type_char:
+            record.value = (unsigned char)node->data.lit.character;
+            break;
+        case cc_type_bool:
+            record.value = node->data.lit.boolean ? 1 : 0;
+            break;
+        case cc_type_undef:
+            break;
+        }
+        break;
+    }
+    }
+
+    return record;
+}
+
+bool cc_write_binary_ast(
+    cc_output_t*            output,
+    cc_compact_ast_t const* ast)
+{
+    cc_binary_strings_t strings = {
+        .length   = 0,
+        .capacity = DEFAULT_OUTPUT_BUFFER_SIZE,
+        .offsets  = cc_create_map(DEFAULT_MAP_SIZE, NULL),
+    };
+
+    strings.text = (char*)cc_try_malloc(strings.capacity, cc_mem_string);
+
+    /* the size of the strings goes in the header, so they're gathered
+     * first, and looked up again as the nodes are written */
+    for (uint32_t i = 0; i < ast->count; i++) {
+        cc_compact_node_t const* node = &ast->nodes[i];
+
+        if (cc_has_binary_string((cc_node_data_kind_t)node->kind, (cc_type_t)node->type))
+            cc_make_binary_node(&strings, node);
+    }
+
+    cc_binary_header_t header = {
+        .magic        = BINARY_AST_MAGIC,
+        .version      = BINARY_AST_VERSION,
+        .node_size    = sizeof(cc_binary_node_t),
+        .count        = ast->count,
+        .root         = ast->root,
+        .strings      = sizeof(cc_binary_header_t) + (uint64_t)ast->count * sizeof(cc_binary_node_t),
+        .strings_size = strings.length,
+    };
+
+    cc_put_output(output, (char const*)&header, sizeof(header));
+
+    for (uint32_t i = 0; i < ast->count; i++) {
+        cc_binary_node_t record = cc_make_binary_node(&strings, &ast->nodes[i]);
+
+        cc_put_output(output, (char const*)&record, sizeof(record));
+    }
+
+    cc_put_output(output, strings.text, strings.length);
+
+    cc_free(strings.text);
+    cc_free_map(strings.offsets);
+
+    return cc_flush_output(output);
+}
+
+cc_binary_ast_t* cc_open_binary_ast(char const* path)
+{
+    cc_input_t* input = cc_open_input(path);
+
+    if (input == NULL)
+        return NULL;
+
+    cc_binary_header_t const* header = (cc_binary_header_t const*)input->text;
+
+    bool sound = input->length >= sizeof(cc_binary_header_t)
+        && memcmp(header->magic, BINARY_AST_MAGIC, sizeof(header->magic)) == 0
+        && header->version == BINARY_AST_VERSION
+        && header->node_size == sizeof(cc_binary_node_t)
+        && header->strings == sizeof(cc_binary_header_t) + (uint64_t)header->count * sizeof(cc_binary_node_t)
+        && header->strings <= input->length
+        && header->strings_size <= input->length - header->strings
+        && (header->root < header->count || (header->root == NO_NODE_ID && header->count == 0))
+        /* so that no string runs past the end of the file */
+        && (header->strings_size == 0 || input->text[header->strings + header->strings_size - 1] == '\0');
+
+    if (!sound) {
+        cc_close_input(input);
+        return NULL;
+    }
+
+    cc_binary_ast_t* ast = (cc_binary_ast_t*)cc_try_malloc(sizeof(cc_binary_ast_t), cc_mem_ast);
+
+    ast->input   = input;
+    ast->header  = header;
+    ast->nodes   = (cc_binary_node_t const*)(input->text + sizeof(cc_binary_header_t));
+    ast->strings = input->text + header->strings;
+
+    return ast;
+}
+
+cc_binary_node_t const* cc_get_binary_node(
+    cc_binary_ast_t const* ast,
+    cc_node_id_t           id)
+{
+    if (id >= ast->header->count)
+        return NULL;
+
+    return &ast->nodes[id];
+}
+
+bool cc_get_binary_data(
+    cc_binary_ast_t const* ast,
+    cc_node_id_t           id,
+    cc_node_data_t*        data)
+{
+    cc_binary_node_t const* node  = cc_get_binary_node(ast, id);
+    uint32_t                count = ast->header->count;
+
+    if (node == NULL || node->kind > cc_call || node->type > cc_type_undef)
+        return false;
+
+    /* pointing only forward, nodes can't make up a cycle */
+    if (node->num_children > 0 && (node->num_children > count || node->children <= id || node->children > count - node->num_children))
+        return false;
+
+    if (node->next != NO_NODE_ID && (node->next <= id || node->next >= count))
+        return false;
+
+    if (cc_has_binary_string((cc_node_data_kind_t)node->kind, (cc_type_t)node->type)) {
+        if (node->value >= ast->header->strings_size)
+            return false;
+
+        if (node->kind == cc_lit)
+            data->lit.string = (char*)(ast->strings + node->value);
+        else
+            data->id = ast->strings + node->value;
+
+        return true;
+    }
+
+    switch ((cc_node_data_kind_t)node->kind) {
+    case cc_expr:
+        data->expr = (cc_expression_t)node->value;
+        return node->value <= cc_expr_un_index;
+    case cc_cmd:
+        data->cmd = (cc_command_t)node->value;
+        return node->value <= cc_cmd_init;
+    case cc_lit: {
+        switch ((cc_type_t)node->type) {
+        case cc_type_float:
+            memcpy(&data->lit.floating, &node->value, sizeof(double));
+            break;
+        case cc_type_int:
+            data->lit.integer = (int)(uint32_t)node->value;
+            break;
+        case cc_type_char:
+            data->lit.character = (char)node->value;
+            break;
+        case cc_type_bool:
+            data->lit.boolean = node->value != 0;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+cc_compact_ast_t* cc_load_compact_ast(cc_binary_ast_t const* ast)
+{
+    cc_compact_ast_t* compact = (cc_compact_ast_t*)cc_try_malloc(sizeof(cc_compact_ast_t), cc_mem_ast);
+    uint32_t          count   = ast->header->count;
+
+    compact->capacity = count > DEFAULT_COMPACT_AST_SIZE ? count : DEFAULT_COMPACT_AST_SIZE;
+    compact->count    = count;
+    compact->nodes    = (cc_compact_node_t*)cc_try_malloc(compact->capacity * sizeof(cc_compact_node_t), cc_mem_ast);
+    compact->root     = ast->header->root;
+    compact->strings  = NULL; /* they're in the file */
+
+    for (cc_node_id_t id = 0; id < count; id++) {
+        cc_binary_node_t const* node = &ast->nodes[id];
+        cc_node_data_t          data = { 0 };
+
+        if (!cc_get_binary_data(ast, id, &data)) {
+            cc_free_compact_ast(compact);
+            return NULL;
+        }
+
+        compact->nodes[id] = (cc_compact_node_t) {
+            .data         = data,
+            .location     = { node->line, node->column, node->length },
+            .kind         = node->kind,
+            .type         = node->type,
+            .num_children = node->num_children,
+            .children     = node->children,
+            .next         = node->next,
+        };
+    }
+
+    return compact;
+}
+
+void cc_close_binary_ast(cc_binary_ast_t* ast)
+{
+    if (ast == NULL)
+        return;
+
+    cc_close_input(ast->input);
+    cc_free(ast);
+
+    return;
+}
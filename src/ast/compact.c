@@ -0,0 +1,217 @@
+/** @file ast/compact.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <string.h>
+
+#include "ast/compact.h"
+#include "ast/walk.h"
+#include "parser/context.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/* what's needed to copy a tree as it's walked */
+typedef struct {
+    cc_compact_ast_t* ast;      /** The compact tree. */
+    cc_node_id_t*     ids;      /** Where the nodes still to be reached go, the next on top. */
+    uint32_t          top;      /** How many of them there are. */
+    uint32_t          capacity; /** How many of them fit in `ids`. */
+} cc_compact_copy_t;
+
+/**
+ * Counts a node of a tree.
+ *
+ * @param node the node.
+ * @param data the count so far.
+ *
+ * @return always true.
+ */
+static bool cc_count_compact_node(
+    cc_ast_t const* node,
+    void*           data);
+
+/**
+ * Reserves room for `count` consecutive nodes, which was already made
+ * when the tree was counted.
+ *
+ * @param ast the compact tree.
+ * @param count how many nodes.
+ *
+ * @return the index of the first of them.
+ */
+static cc_node_id_t cc_reserve_compact_nodes(
+    cc_compact_ast_t* ast,
+    uint32_t          count);
+
+/**
+ * Marks where a node still to be reached goes.
+ *
+ * @param copy the copy.
+ * @param id where it goes.
+ */
+static void cc_push_compact_id(
+    cc_compact_copy_t* copy,
+    cc_node_id_t       id);
+
+/**
+ * Copies a node into the compact tree, reserving room for its children
+ * and the node after it, as they're reached right after it.
+ *
+ * @param node the node.
+ * @param data the copy.
+ *
+ * @return always true.
+ */
+static bool cc_copy_compact_node(
+    cc_ast_t const* node,
+    void*           data);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+bool cc_count_compact_node(
+    cc_ast_t const* node,
+    void*           data)
+{
+    (void)node;
+    (*(uint32_t*)data)++;
+
+    return true;
+}
+
+cc_node_id_t cc_reserve_compact_nodes(
+    cc_compact_ast_t* ast,
+    uint32_t          count)
+{
+    cc_node_id_t first = ast->count;
+
+    ast->count += count;
+
+    return first;
+}
+
+void cc_push_compact_id(
+    cc_compact_copy_t* copy,
+    cc_node_id_t       id)
+{
+    if (copy->top == copy->capacity) {
+        copy->capacity *= 2;
+        copy->ids = (cc_node_id_t*)cc_try_realloc(copy->ids, copy->capacity * sizeof(cc_node_id_t), cc_mem_stack);
+    }
+
+    copy->ids[copy->top++] = id;
+
+    return;
+}
+
+bool cc_copy_compact_node(
+    cc_ast_t const* node,
+    void*           data)
+{
+    cc_compact_copy_t* copy = (cc_compact_copy_t*)data;
+    cc_compact_ast_t*  ast  = copy->ast;
+    cc_node_id_t       id   = copy->ids[--copy->top];
+
+    cc_node_id_t   children = node->num_children > 0 ? cc_reserve_compact_nodes(ast, node->num_children) : NO_NODE_ID;
+    cc_node_id_t   next     = node->next != NULL ? cc_reserve_compact_nodes(ast, 1) : NO_NODE_ID;
+    cc_node_data_t content  = node->content->data;
+
+    if (node->content->kind == cc_lit && node->content->type == cc_type_string)
+        content.lit.string = cc_strndup_arena(ast->strings, content.lit.string, strlen(content.lit.string));
+
+    ast->nodes[id] = (cc_compact_node_t) {
+        .data         = content,
+        .location     = node->content->location,
+        .kind         = (uint8_t)node->content->kind,
+        .type         = (uint8_t)node->content->type,
+        .num_children = node->num_children,
+        .children     = children,
+        .next         = next,
+    };
+
+    /* the children are walked before the rest of the sequence, in order */
+    if (next != NO_NODE_ID)
+        cc_push_compact_id(copy, next);
+
+    for (uint8_t i = node->num_children; i > 0; i--)
+        cc_push_compact_id(copy, children + i - 1);
+
+    return true;
+}
+
+cc_compact_ast_t* cc_create_compact_ast(cc_ast_t const* ast)
+{
+    cc_compact_ast_t* compact = (cc_compact_ast_t*)cc_try_malloc(sizeof(cc_compact_ast_t), cc_mem_ast);
+    uint32_t          count   = 0;
+
+    /* counted first, the nodes are allocated once and at their size */
+    cc_walk_ast(ast, &(cc_ast_visitor_t) { .pre = cc_count_compact_node, .data = &count });
+
+    compact->capacity = count > 0 ? count : 1;
+    compact->count    = 0;
+    compact->nodes    = (cc_compact_node_t*)cc_try_malloc(compact->capacity * sizeof(cc_compact_node_t), cc_mem_ast);
+    compact->root     = NO_NODE_ID;
+    compact->strings  = cc_create_arena(DEFAULT_ARENA_BLOCK_SIZE);
+
+    if (ast != NULL) {
+        cc_compact_copy_t copy = {
+            .ast      = compact,
+            .top      = 0,
+            .capacity = DEFAULT_WALK_STACK_SIZE,
+        };
+
+        copy.ids = (cc_node_id_t*)cc_try_malloc(copy.capacity * sizeof(cc_node_id_t), cc_mem_stack);
+
+        compact->root = cc_reserve_compact_nodes(compact, 1);
+        cc_push_compact_id(&copy, compact->root);
+        cc_walk_ast(ast, &(cc_ast_visitor_t) { .pre = cc_copy_compact_node, .data = &copy });
+
+        cc_free(copy.ids);
+    }
+
+    return compact;
+}
+
+cc_compact_ast_t* cc_take_compact_ast(cc_context_t* context)
+{
+    cc_compact_ast_t* compact = cc_create_compact_ast(context->ast);
+
+    cc_free_ast(context);
+
+    return compact;
+}
+
+cc_node_id_t cc_get_nth_child_compact(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            parent,
+    uint8_t                 ordinal)
+{
+    cc_compact_node_t const* node = &ast->nodes[parent];
+
+    if (ordinal > node->num_children || ordinal == 0)
+        return NO_NODE_ID;
+
+    return node->children + ordinal - 1;
+}
+
+void cc_free_compact_ast(cc_compact_ast_t* ast)
+{
+    if (ast == NULL)
+        return;
+
+    cc_free_arena(ast->strings);
+    cc_free(ast->nodes);
+    cc_free(ast);
+
+    return;
+}
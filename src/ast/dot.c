@@ -0,0 +1,338 @@
+/** @file ast/dot.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ast/dot.h"
+#include "ast/print.h"
+#include "ast/walk.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Makes room for more ids in both stacks of a writer.
+ *
+ * @param writer the writer.
+ * @param needed how many more ids must fit in the pending stack.
+ */
+static void cc_reserve_dot_ids(
+    cc_dot_writer_t* writer,
+    uint32_t         needed);
+
+/**
+ * Gives ids to the children and to the next node of the node just
+ * reached, and writes an edge to each of them.
+ *
+ * @param writer the writer.
+ * @param num_children how many children the node has.
+ * @param has_next whether there's a node after it.
+ */
+static void cc_reach_dot_node(
+    cc_dot_writer_t* writer,
+    uint32_t         num_children,
+    bool             has_next);
+
+/**
+ * Writes the label of the last node reached but not labeled yet.
+ *
+ * @param writer the writer.
+ * @param kind the kind of the node.
+ * @param type its type.
+ * @param data its data.
+ */
+static void cc_label_dot_node(
+    cc_dot_writer_t*    writer,
+    cc_node_data_kind_t kind,
+    cc_type_t           type,
+    cc_node_data_t      data);
+
+/**
+ * Reaches a node of a tree being walked.
+ *
+ * @param node the node.
+ * @param data the writer.
+ *
+ * @return true, as every child is exported.
+ */
+static bool cc_reach_dot_walk(
+    cc_ast_t const* node,
+    void*           data);
+
+/**
+ * Labels a node of a tree being walked.
+ *
+ * @param node the node.
+ * @param data the writer.
+ */
+static void cc_label_dot_walk(
+    cc_ast_t const* node,
+    void*           data);
+
+/**
+ * Reaches a node of a compact tree being walked.
+ *
+ * @param ast the compact tree.
+ * @param id the node.
+ * @param data the writer.
+ *
+ * @return true, as every child is exported.
+ */
+static bool cc_reach_compact_dot_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data);
+
+/**
+ * Labels a node of a compact tree being walked.
+ *
+ * @param ast the compact tree.
+ * @param id the node.
+ * @param data the writer.
+ */
+static void cc_label_compact_dot_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_reserve_dot_ids(
+    cc_dot_writer_t* writer,
+    uint32_t         needed)
+{
+    /* both stacks are the same size. A node is labeled only once the
+     * rest of its sequence is, so every node before it in its sequence
+     * is still open, as are those of its ancestors: as many as there are
+     * nodes along the way, counting each `next` followed, which a whole
+     * function body can take. The open stack is then checked each time */
+    if (writer->waiting + needed <= writer->size && writer->opened < writer->size)
+        return;
+
+    while (writer->waiting + needed > writer->size || writer->opened >= writer->size)
+        writer->size *= 2;
+
+    writer->pending = (uint32_t*)cc_try_realloc(writer->pending, writer->size * sizeof(uint32_t), cc_mem_stack);
+    writer->open    = (uint32_t*)cc_try_realloc(writer->open, writer->size * sizeof(uint32_t), cc_mem_stack);
+
+    return;
+}
+
+void cc_reach_dot_node(
+    cc_dot_writer_t* writer,
+    uint32_t         num_children,
+    bool             has_next)
+{
+    uint32_t edges = num_children + (has_next ? 1 : 0);
+    uint32_t id    = writer->pending[--writer->waiting];
+    uint32_t first = writer->count;
+
+    cc_reserve_dot_ids(writer, edges);
+    writer->count += edges;
+
+    /* the nodes are reached in the order they're mentioned, so the first
+     * one goes on top */
+    for (uint32_t i = edges; i > 0; i--)
+        writer->pending[writer->waiting++] = first + i - 1;
+
+    writer->open[writer->opened++] = id;
+
+    for (uint32_t i = 0; i < edges; i++) {
+        cc_put_output_number(writer->output, id, false);
+        cc_put_output(writer->output, ", ", 2);
+        cc_put_output_number(writer->output, first + i, false);
+        cc_put_output(writer->output, "\n", 1);
+    }
+
+    return;
+}
+
+void cc_label_dot_node(
+    cc_dot_writer_t*    writer,
+    cc_node_data_kind_t kind,
+    cc_type_t           type,
+    cc_node_data_t      data)
+{
+    cc_put_output_number(writer->output, writer->open[--writer->opened], false);
+    cc_put_output(writer->output, " [label=\"", 9);
+
+    switch (kind) {
+    case cc_call:
+        cc_put_output(writer->output, "call ", 5);
+        cc_put_output(writer->output, data.id, strlen(data.id));
+        break;
+    case cc_id:
+    case cc_func:
+        cc_put_output(writer->output, data.id, strlen(data.id));
+        break;
+    case cc_lit: {
+        switch (type) {
+        case cc_type_string:
+            cc_put_output(writer->output, data.lit.string, strlen(data.lit.string));
+            break;
+        case cc_type_char:
+            cc_put_output(writer->output, &data.lit.character, 1);
+            break;
+        case cc_type_int: {
+            bool negative = data.lit.integer < 0;
+
+            /* negated as unsigned, which holds the smallest integer too */
+            cc_put_output_number(writer->output, negative ? 0u - (uint32_t)data.lit.integer : (uint32_t)data.lit.integer, negative);
+            break;
+        }
+        case cc_type_float: {
+            /* floats are rare enough to be left to the C library */
+            char number[512];
+            int  length = snprintf(number, sizeof(number), "%.5f", data.lit.floating);
+
+            cc_put_output(writer->output, number, (size_t)length < sizeof(number) ? (size_t)length : sizeof(number) - 1);
+            break;
+        }
+        case cc_type_bool:
+            if (data.lit.boolean)
+                cc_put_output(writer->output, "true", 4);
+            else
+                cc_put_output(writer->output, "false", 5);
+            break;
+        case cc_type_undef:
+            break;
+        }
+        break;
+    }
+    case cc_expr:
+    case cc_cmd: {
+        char const* symbol = cc_get_ast_symbol(kind, data);
+
+        cc_put_output(writer->output, symbol, strlen(symbol));
+        break;
+    }
+    }
+
+    cc_put_output(writer->output, "\"]\n", 3);
+
+    return;
+}
+
+bool cc_reach_dot_walk(
+    cc_ast_t const* node,
+    void*           data)
+{
+    cc_reach_dot_node((cc_dot_writer_t*)data, node->num_children, node->next != NULL);
+
+    return true;
+}
+
+void cc_label_dot_walk(
+    cc_ast_t const* node,
+    void*           data)
+{
+    cc_label_dot_node((cc_dot_writer_t*)data, node->content->kind, node->content->type, node->content->data);
+
+    return;
+}
+
+bool cc_reach_compact_dot_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data)
+{
+    cc_compact_node_t const* node = &ast->nodes[id];
+
+    cc_reach_dot_node((cc_dot_writer_t*)data, node->num_children, node->next != NO_NODE_ID);
+
+    return true;
+}
+
+void cc_label_compact_dot_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data)
+{
+    cc_compact_node_t const* node = &ast->nodes[id];
+
+    cc_label_dot_node((cc_dot_writer_t*)data, (cc_node_data_kind_t)node->kind, (cc_type_t)node->type, node->data);
+
+    return;
+}
+
+cc_dot_writer_t* cc_create_dot_writer(cc_output_t* output)
+{
+    cc_dot_writer_t* writer = (cc_dot_writer_t*)cc_try_malloc(sizeof(cc_dot_writer_t), cc_mem_misc);
+
+    writer->output  = output;
+    writer->count   = 0;
+    writer->size    = DEFAULT_DOT_STACK_SIZE;
+    writer->pending = (uint32_t*)cc_try_malloc(writer->size * sizeof(uint32_t), cc_mem_stack);
+    writer->waiting = 0;
+    writer->open    = (uint32_t*)cc_try_malloc(writer->size * sizeof(uint32_t), cc_mem_stack);
+    writer->opened  = 0;
+
+    return writer;
+}
+
+bool cc_write_dot_ast(
+    cc_dot_writer_t* writer,
+    cc_ast_t const*  ast)
+{
+    cc_ast_visitor_t visitor = {
+        .pre  = cc_reach_dot_walk,
+        .post = cc_label_dot_walk,
+        .data = writer,
+    };
+
+    /* the first node is the only one not mentioned by another */
+    writer->count                      = 1;
+    writer->pending[writer->waiting++] = 0;
+
+    cc_walk_ast(ast, &visitor);
+
+    /* nothing was reached if there was no tree */
+    writer->waiting = 0;
+
+    return cc_flush_output(writer->output);
+}
+
+bool cc_write_dot_compact_ast(
+    cc_dot_writer_t*        writer,
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id)
+{
+    cc_compact_ast_visitor_t visitor = {
+        .pre  = cc_reach_compact_dot_walk,
+        .post = cc_label_compact_dot_walk,
+        .data = writer,
+    };
+
+    writer->count                      = 1;
+    writer->pending[writer->waiting++] = 0;
+
+    cc_walk_compact_ast(ast, id, &visitor);
+
+    writer->waiting = 0;
+
+    return cc_flush_output(writer->output);
+}
+
+void cc_free_dot_writer(cc_dot_writer_t* writer)
+{
+    if (writer == NULL)
+        return;
+
+    cc_free(writer->pending);
+    cc_free(writer->open);
+    cc_free(writer);
+
+    return;
+}
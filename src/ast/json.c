@@ -0,0 +1,335 @@
+/** @file ast/json.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ast/json.h"
+#include "ast/print.h"
+#include "ast/walk.h"
+#include "semantics/values.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/* where an export is at */
+typedef struct {
+    cc_output_t* output;
+    bool         first;     /** Whether nothing was written in the current array. */
+    bool         continues; /** Whether the node coming next continues a sequence. */
+} cc_json_state_t;
+
+static char const* const cc_json_kinds[] = {
+    [cc_id]   = "id",
+    [cc_lit]  = "lit",
+    [cc_expr] = "expr",
+    [cc_cmd]  = "cmd",
+    [cc_func] = "func",
+    [cc_call] = "call",
+};
+
+static char const* const cc_json_types[] = {
+    [cc_type_string] = "string",
+    [cc_type_float]  = "float",
+    [cc_type_int]    = "int",
+    [cc_type_char]   = "char",
+    [cc_type_bool]   = "bool",
+    [cc_type_undef]  = "undef",
+};
+
+static char const* const cc_json_symbol_kinds[] = {
+    [cc_symb_var]   = "var",
+    [cc_symb_func]  = "func",
+    [cc_symb_array] = "array",
+};
+
+/**
+ * Appends text to the output as a JSON string, quotes included. Sources
+ * aren't known to be UTF-8, so bytes outside ASCII are escaped as the
+ * code point of the same value, which keeps the output valid and lets
+ * the original bytes be recovered.
+ *
+ * @param output the output.
+ * @param text the text.
+ * @param length how many characters of text there are.
+ */
+static void cc_put_json_string(
+    cc_output_t* output,
+    char const*  text,
+    size_t       length);
+
+/**
+ * Appends the value of a node to the output.
+ *
+ * @param output the output.
+ * @param content what the node holds.
+ */
+static void cc_put_json_value(
+    cc_output_t*            output,
+    cc_lexic_value_t const* content);
+
+/**
+ * Appends the declaration an identifier was resolved to to the output.
+ *
+ * @param output the output.
+ * @param symbol the declaration.
+ */
+static void cc_put_json_symbol(
+    cc_output_t*     output,
+    cc_symb_t const* symbol);
+
+/**
+ * Opens a node as the walk reaches it, and opens a sequence before it if
+ * it doesn't continue one.
+ *
+ * @param node the node.
+ * @param data the state of the export.
+ *
+ * @return true, as every child is exported.
+ */
+static bool cc_open_json_walk(
+    cc_ast_t const* node,
+    void*           data);
+
+/**
+ * Closes a node once its children were walked, and the sequence as well
+ * if the node is the last in it.
+ *
+ * @param node the node.
+ * @param data the state of the export.
+ */
+static void cc_close_json_walk(
+    cc_ast_t const* node,
+    void*           data);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_put_json_string(
+    cc_output_t* output,
+    char const*  text,
+    size_t       length)
+{
+    static char const hex[] = "0123456789abcdef";
+
+    size_t start = 0;
+
+    cc_put_output(output, "\"", 1);
+
+    /* runs of plain characters are copied at once */
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\')
+            continue;
+
+        cc_put_output(output, text + start, i - start);
+        start = i + 1;
+
+        switch (c) {
+        case '"':
+            cc_put_output(output, "\\\"", 2);
+            break;
+        case '\\':
+            cc_put_output(output, "\\\\", 2);
+            break;
+        case '\n':
+            cc_put_output(output, "\\n", 2);
+            break;
+        case '\t':
+            cc_put_output(output, "\\t", 2);
+            break;
+        default: {
+            char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+
+            cc_put_output(output, escape, sizeof(escape));
+            break;
+        }
+        }
+    }
+
+    cc_put_output(output, text + start, length - start);
+    cc_put_output(output, "\"", 1);
+
+    return;
+}
+
+void cc_put_json_value(
+    cc_output_t*            output,
+    cc_lexic_value_t const* content)
+{
+    cc_node_data_t data = content->data;
+
+    switch (content->kind) {
+    case cc_id:
+    case cc_func:
+    case cc_call:
+        cc_put_json_string(output, data.id, strlen(data.id));
+        break;
+    case cc_lit: {
+        switch (content->type) {
+        case cc_type_string:
+            cc_put_json_string(output, data.lit.string, strlen(data.lit.string));
+            break;
+        case cc_type_char:
+            cc_put_json_string(output, &data.lit.character, 1);
+            break;
+        case cc_type_int: {
+            bool negative = data.lit.integer < 0;
+
+            cc_put_output_number(output, negative ? 0u - (uint32_t)data.lit.integer : (uint32_t)data.lit.integer, negative);
+            break;
+        }
+        case cc_type_float: {
+            /* JSON has no infinities, and floats are rare enough to be
+             * left to the C library */
+            char number[32];
+            int  length = snprintf(number, sizeof(number), "%.17g", data.lit.floating);
+
+            if (isfinite(data.lit.floating))
+                cc_put_output(output, number, (size_t)length);
+            else
+                cc_put_output(output, "null", 4);
+            break;
+        }
+        case cc_type_bool:
+            if (data.lit.boolean)
+                cc_put_output(output, "true", 4);
+            else
+                cc_put_output(output, "false", 5);
+            break;
+        case cc_type_undef:
+            cc_put_output(output, "null", 4);
+            break;
+        }
+        break;
+    }
+    case cc_expr:
+    case cc_cmd: {
+        char const* symbol = cc_get_ast_symbol(content->kind, data);
+
+        cc_put_json_string(output, symbol, strlen(symbol));
+        break;
+    }
+    }
+
+    return;
+}
+
+void cc_put_json_symbol(
+    cc_output_t*     output,
+    cc_symb_t const* symbol)
+{
+    char const* kind = cc_json_symbol_kinds[symbol->kind];
+    char const* type = cc_json_types[symbol->type];
+
+    cc_put_output(output, "{\"kind\":\"", 9);
+    cc_put_output(output, kind, strlen(kind));
+    cc_put_output(output, "\",\"type\":\"", 10);
+    cc_put_output(output, type, strlen(type));
+    cc_put_output(output, "\",\"size\":", 9);
+    cc_put_output_number(output, symbol->size, false);
+    cc_put_output(output, ",\"line\":", 8);
+    cc_put_output_number(output, symbol->location.line, false);
+    cc_put_output(output, ",\"column\":", 10);
+    cc_put_output_number(output, symbol->location.column, false);
+    cc_put_output(output, "}", 1);
+
+    return;
+}
+
+bool cc_open_json_walk(
+    cc_ast_t const* node,
+    void*           data)
+{
+    cc_json_state_t*        state   = (cc_json_state_t*)data;
+    cc_output_t*            output  = state->output;
+    cc_lexic_value_t const* content = node->content;
+
+    if (!state->continues)
+        cc_put_output(output, state->first ? "[" : ",[", state->first ? 1 : 2);
+
+    char const* kind = cc_json_kinds[content->kind];
+    char const* type = cc_json_types[content->type];
+
+    cc_put_output(output, "\n{\"kind\":\"", 10);
+    cc_put_output(output, kind, strlen(kind));
+    cc_put_output(output, "\",\"type\":\"", 10);
+    cc_put_output(output, type, strlen(type));
+    cc_put_output(output, "\",\"value\":", 10);
+    cc_put_json_value(output, content);
+    cc_put_output(output, ",\"line\":", 8);
+    cc_put_output_number(output, content->location.line, false);
+    cc_put_output(output, ",\"column\":", 10);
+    cc_put_output_number(output, content->location.column, false);
+    cc_put_output(output, ",\"length\":", 10);
+    cc_put_output_number(output, content->location.length, false);
+
+    if (content->symbol != NULL) {
+        cc_put_output(output, ",\"symbol\":", 10);
+        cc_put_json_symbol(output, content->symbol);
+    }
+
+    cc_put_output(output, ",\"children\":[", 13);
+
+    state->first     = true;
+    state->continues = false;
+
+    return true;
+}
+
+void cc_close_json_walk(
+    cc_ast_t const* node,
+    void*           data)
+{
+    cc_json_state_t* state = (cc_json_state_t*)data;
+
+    if (node->next != NULL) {
+        cc_put_output(state->output, "]},", 3);
+        state->continues = true;
+    } else {
+        cc_put_output(state->output, "]}]", 3);
+        state->first     = false;
+        state->continues = false;
+    }
+
+    return;
+}
+
+bool cc_write_json_ast(
+    cc_output_t*    output,
+    cc_ast_t const* ast)
+{
+    cc_json_state_t state = {
+        .output    = output,
+        .first     = true,
+        .continues = false,
+    };
+
+    /* closing each node before the rest of its sequence keeps the walk
+     * from stacking up sequences */
+    cc_ast_visitor_t visitor = {
+        .pre   = cc_open_json_walk,
+        .visit = cc_close_json_walk,
+        .data  = &state,
+    };
+
+    if (ast == NULL)
+        cc_put_output(output, "[]", 2);
+
+    cc_walk_ast(ast, &visitor);
+    cc_put_output(output, "\n", 1);
+
+    return cc_flush_output(output);
+}
@@ -12,6 +12,115 @@
  */
 
 #include "ast/print.h"
+#include "ast/walk.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Prints the edges of a node, as a walk reaches it.
+ *
+ * @param node the node.
+ * @param data unused.
+ *
+ * @return true, as every child is printed.
+ */
+static bool cc_print_edges_walk(
+    cc_ast_t const* node,
+    void*           data);
+
+/**
+ * Prints the label of a node, once the walk is done with it.
+ *
+ * @param node the node.
+ * @param data unused.
+ */
+static void cc_print_label_walk(
+    cc_ast_t const* node,
+    void*           data);
+
+/**
+ * Prints the edges of a compact node, as a walk reaches it.
+ *
+ * @param ast the compact tree.
+ * @param id the node.
+ * @param data unused.
+ *
+ * @return true, as every child is printed.
+ */
+static bool cc_print_compact_edges_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data);
+
+/**
+ * Prints the label of a compact node, once the walk is done with it.
+ *
+ * @param ast the compact tree.
+ * @param id the node.
+ * @param data unused.
+ */
+static void cc_print_compact_label_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+bool cc_print_edges_walk(
+    cc_ast_t const* node,
+    void*           data)
+{
+    (void)data;
+    cc_print_ast_children(node);
+
+    return true;
+}
+
+void cc_print_label_walk(
+    cc_ast_t const* node,
+    void*           data)
+{
+    (void)data;
+    cc_print_ast_node(node);
+
+    return;
+}
+
+bool cc_print_compact_edges_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data)
+{
+    (void)data;
+
+    cc_compact_node_t const* node = &ast->nodes[id];
+
+    for (unsigned int i = 0; i < node->num_children; i++)
+        printf("%p, %p\n", (void*)node, (void*)&ast->nodes[node->children + i]);
+
+    if (node->next != NO_NODE_ID)
+        printf("%p, %p\n", (void*)node, (void*)&ast->nodes[node->next]);
+
+    return true;
+}
+
+void cc_print_compact_label_walk(
+    cc_compact_ast_t const* ast,
+    cc_node_id_t            id,
+    void*                   data)
+{
+    (void)data;
+
+    cc_compact_node_t const* node = &ast->nodes[id];
+
+    printf("%p [label=\"", (void*)node);
+    cc_print_ast_label((cc_node_data_kind_t)node->kind, (cc_type_t)node->type, node->data);
+    fputs("\"]\n", stdout);
+
+    return;
+}
 
 void cc_print_ast_children(cc_ast_t const* restrict node)
 {
@@ -24,154 +133,146 @@ void cc_print_ast_children(cc_ast_t const* restrict node)
     return;
 }
 
-void cc_print_ast_node(cc_ast_t const* restrict node)
+char const* cc_get_ast_symbol(
+    cc_node_data_kind_t kind,
+    cc_node_data_t      data)
 {
-    printf("%p [label=\"", (void*)node);
-
-    switch (node->content->kind) {
-    case cc_call:
-        printf("call %s", node->content->data.id);
-        break;
-    case cc_id:
-    case cc_func:
-        printf("%s", node->content->data.id);
-        break;
-    case cc_lit: {
-        switch (node->content->type) {
-        case cc_type_string:
-            printf("%s", node->content->data.lit.string);
-            break;
-        case cc_type_char:
-            printf("%c", node->content->data.lit.character);
-            break;
-        case cc_type_int:
-            printf("%d", node->content->data.lit.integer);
-            break;
-        case cc_type_float:
-            printf("%.5f", node->content->data.lit.floating);
-            break;
-        case cc_type_bool:
-            printf("%s", node->content->data.lit.boolean ? "true" : "false");
-            break;
-        case cc_type_undef:
-            break;
-        }
-        break;
-    }
+    switch (kind) {
     case cc_expr: {
-        switch (node->content->data.expr) {
+        switch (data.expr) {
         case cc_expr_bin_add:
         case cc_expr_un_sign_pos:
-            fputs("+", stdout);
-            break;
+            return "+";
         case cc_expr_bin_sub:
         case cc_expr_un_sign_neg:
-            fputs("-", stdout);
-            break;
+            return "-";
         case cc_expr_bin_mul:
         case cc_expr_un_deref:
-            fputs("*", stdout);
-            break;
+            return "*";
         case cc_expr_bin_div:
-            fputs("/", stdout);
-            break;
+            return "/";
         case cc_expr_bin_exp:
-            fputs("^", stdout);
-            break;
+            return "^";
         case cc_expr_bin_rem:
-            fputs("%", stdout);
-            break;
+            return "%";
         case cc_expr_bin_or:
-            fputs("|", stdout);
-            break;
+            return "|";
         case cc_expr_bin_and:
         case cc_expr_un_addr:
-            fputs("&", stdout);
-            break;
+            return "&";
         case cc_expr_un_hash:
-            fputs("#", stdout);
-            break;
+            return "#";
         case cc_expr_un_negat:
-            fputs("!", stdout);
-            break;
+            return "!";
         case cc_expr_un_logic:
-            fputs("?", stdout);
-            break;
+            return "?";
         case cc_expr_un_index:
-            fputs("[]", stdout);
-            break;
+            return "[]";
         case cc_expr_log_and:
-            fputs("&&", stdout);
-            break;
+            return "&&";
         case cc_expr_log_or:
-            fputs("||", stdout);
-            break;
+            return "||";
         case cc_expr_log_ge:
-            fputs(">=", stdout);
-            break;
+            return ">=";
         case cc_expr_log_le:
-            fputs("<=", stdout);
-            break;
+            return "<=";
         case cc_expr_log_gt:
-            fputs(">", stdout);
-            break;
+            return ">";
         case cc_expr_log_lt:
-            fputs("<", stdout);
-            break;
+            return "<";
         case cc_expr_log_eq:
-            fputs("==", stdout);
-            break;
+            return "==";
         case cc_expr_log_ne:
-            fputs("!=", stdout);
-            break;
+            return "!=";
         case cc_expr_tern:
-            fputs("?:", stdout);
-            break;
+            return "?:";
         }
         break;
     }
     case cc_cmd: {
-        switch (node->content->data.cmd) {
+        switch (data.cmd) {
         case cc_cmd_atrib:
-            fputs("=", stdout);
-            break;
+            return "=";
         case cc_cmd_init:
-            fputs("<=", stdout);
-            break;
+            return "<=";
         case cc_cmd_shift_left:
-            fputs("<<", stdout);
-            break;
+            return "<<";
         case cc_cmd_shift_right:
-            fputs(">>", stdout);
-            break;
+            return ">>";
         case cc_cmd_for:
-            fputs("for", stdout);
-            break;
+            return "for";
         case cc_cmd_while:
-            fputs("while", stdout);
-            break;
+            return "while";
         case cc_cmd_if:
-            fputs("if", stdout);
-            break;
+            return "if";
         case cc_cmd_break:
-            fputs("break", stdout);
-            break;
+            return "break";
         case cc_cmd_continue:
-            fputs("continue", stdout);
-            break;
+            return "continue";
         case cc_cmd_return:
-            fputs("return", stdout);
-            break;
+            return "return";
         case cc_cmd_input:
-            fputs("input", stdout);
-            break;
+            return "input";
         case cc_cmd_output:
-            fputs("output", stdout);
+            return "output";
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return NULL;
+}
+
+void cc_print_ast_label(
+    cc_node_data_kind_t kind,
+    cc_type_t           type,
+    cc_node_data_t      data)
+{
+    switch (kind) {
+    case cc_call:
+        printf("call %s", data.id);
+        break;
+    case cc_id:
+    case cc_func:
+        printf("%s", data.id);
+        break;
+    case cc_lit: {
+        switch (type) {
+        case cc_type_string:
+            printf("%s", data.lit.string);
+            break;
+        case cc_type_char:
+            printf("%c", data.lit.character);
+            break;
+        case cc_type_int:
+            printf("%d", data.lit.integer);
+            break;
+        case cc_type_float:
+            printf("%.5f", data.lit.floating);
+            break;
+        case cc_type_bool:
+            printf("%s", data.lit.boolean ? "true" : "false");
+            break;
+        case cc_type_undef:
             break;
         }
+        break;
     }
+    case cc_expr:
+    case cc_cmd:
+        fputs(cc_get_ast_symbol(kind, data), stdout);
+        break;
     }
 
+    return;
+}
+
+void cc_print_ast_node(cc_ast_t const* restrict node)
+{
+    printf("%p [label=\"", (void*)node);
+    cc_print_ast_label(node->content->kind, node->content->type, node->content->data);
     fputs("\"]\n", stdout);
 
     return;
@@ -179,18 +280,27 @@ void cc_print_ast_node(cc_ast_t const* restrict node)
 
 void cc_print_ast(cc_ast_t const* restrict ast)
 {
-    if (ast == NULL)
-        return;
+    /* the label of a node comes after everything below and after it */
+    cc_ast_visitor_t visitor = {
+        .pre  = cc_print_edges_walk,
+        .post = cc_print_label_walk,
+    };
 
-    cc_print_ast_children(ast);
+    cc_walk_ast(ast, &visitor);
 
-    for (unsigned int i = 0; i < ast->num_children; i++)
-        cc_print_ast(ast->children[i]);
+    return;
+}
 
-    if (ast->next != NULL)
-        cc_print_ast(ast->next);
+void cc_print_compact_ast(
+    cc_compact_ast_t const* restrict ast,
+    cc_node_id_t                     id)
+{
+    cc_compact_ast_visitor_t visitor = {
+        .pre  = cc_print_compact_edges_walk,
+        .post = cc_print_compact_label_walk,
+    };
 
-    cc_print_ast_node(ast);
+    cc_walk_compact_ast(ast, id, &visitor);
 
     return;
 }
@@ -0,0 +1,174 @@
+/** @file ast/walk.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include "ast/walk.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/* a node still to be finished, with what's been done of it */
+typedef struct {
+    cc_ast_t const* node;
+    uint32_t        position; /** The next child, then `num_children` for the rest. */
+} cc_walk_frame_t;
+
+typedef struct {
+    cc_node_id_t id;
+    uint32_t     position; /** The next child, then `num_children` for the rest. */
+} cc_compact_walk_frame_t;
+
+/**
+ * Grows a stack of frames if it's full.
+ *
+ * @param frames the frames.
+ * @param size the size of each frame.
+ * @param top how many frames are in use.
+ * @param capacity how many frames fit, updated if grown.
+ *
+ * @return the frames, which may have moved.
+ */
+static void* cc_grow_walk_stack(
+    void*     frames,
+    size_t    size,
+    uint32_t  top,
+    uint32_t* capacity);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void* cc_grow_walk_stack(
+    void*     frames,
+    size_t    size,
+    uint32_t  top,
+    uint32_t* capacity)
+{
+    if (top < *capacity)
+        return frames;
+
+    *capacity *= 2;
+
+    return cc_try_realloc(frames, *capacity * size, cc_mem_stack);
+}
+
+void cc_walk_ast(
+    cc_ast_t const*         ast,
+    cc_ast_visitor_t const* visitor)
+{
+    if (ast == NULL)
+        return;
+
+    uint32_t         capacity = DEFAULT_WALK_STACK_SIZE;
+    uint32_t         top      = 0;
+    cc_walk_frame_t* frames   = (cc_walk_frame_t*)cc_try_malloc(capacity * sizeof(cc_walk_frame_t), cc_mem_stack);
+    cc_ast_t const*  entering = ast;
+
+    for (;;) {
+        if (entering != NULL) {
+            frames = (cc_walk_frame_t*)cc_grow_walk_stack(frames, sizeof(cc_walk_frame_t), top, &capacity);
+
+            bool children = visitor->pre == NULL || visitor->pre(entering, visitor->data);
+
+            frames[top++] = (cc_walk_frame_t) { entering, children ? 0 : entering->num_children };
+            entering      = NULL;
+        }
+
+        if (top == 0)
+            break;
+
+        cc_walk_frame_t* frame = &frames[top - 1];
+        cc_ast_t const*  node  = frame->node;
+
+        if (frame->position < node->num_children) {
+            entering = node->children[frame->position++];
+            continue;
+        }
+
+        if (frame->position == node->num_children) {
+            frame->position++;
+
+            if (visitor->visit != NULL)
+                visitor->visit(node, visitor->data);
+
+            /* with nothing left to do, the node makes room for the next */
+            if (visitor->post == NULL)
+                top--;
+
+            entering = node->next;
+            continue;
+        }
+
+        visitor->post(node, visitor->data);
+        top--;
+    }
+
+    cc_free(frames);
+
+    return;
+}
+
+void cc_walk_compact_ast(
+    cc_compact_ast_t const*         ast,
+    cc_node_id_t                    id,
+    cc_compact_ast_visitor_t const* visitor)
+{
+    if (id == NO_NODE_ID)
+        return;
+
+    uint32_t                 capacity = DEFAULT_WALK_STACK_SIZE;
+    uint32_t                 top      = 0;
+    cc_compact_walk_frame_t* frames   = (cc_compact_walk_frame_t*)cc_try_malloc(capacity * sizeof(cc_compact_walk_frame_t), cc_mem_stack);
+    cc_node_id_t             entering = id;
+
+    for (;;) {
+        if (entering != NO_NODE_ID) {
+            frames = (cc_compact_walk_frame_t*)cc_grow_walk_stack(frames, sizeof(cc_compact_walk_frame_t), top, &capacity);
+
+            bool children = visitor->pre == NULL || visitor->pre(ast, entering, visitor->data);
+
+            frames[top++] = (cc_compact_walk_frame_t) { entering, children ? 0 : ast->nodes[entering].num_children };
+            entering      = NO_NODE_ID;
+        }
+
+        if (top == 0)
+            break;
+
+        cc_compact_walk_frame_t* frame = &frames[top - 1];
+        cc_compact_node_t const* node  = &ast->nodes[frame->id];
+
+        if (frame->position < node->num_children) {
+            entering = node->children + frame->position++;
+            continue;
+        }
+
+        if (frame->position == node->num_children) {
+            frame->position++;
+
+            if (visitor->visit != NULL)
+                visitor->visit(ast, frame->id, visitor->data);
+
+            /* with nothing left to do, the node makes room for the next */
+            if (visitor->post == NULL)
+                top--;
+
+            entering = node->next;
+            continue;
+        }
+
+        visitor->post(ast, frame->id, visitor->data);
+        top--;
+    }
+
+    cc_free(frames);
+
+    return;
+}
@@ -0,0 +1,85 @@
+/** @file client.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lexer/input.h"
+#include "parser/driver.h"
+#include "parser/server.h"
+
+#define USAGE "usage: %s [--socket=path] [--fast-lexer] [--token-array] [--compact] [--dot] [--emit=dot|json|binary] [--stop] [file]\n"
+
+int main(int argc, char** argv)
+{
+    char const* socket = DEFAULT_SERVER_PATH;
+    char const* path   = NULL;
+    uint32_t    flags  = 0;
+    cc_emit_t   emit   = cc_emit_dot;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--socket=", 9) == 0) {
+            socket = argv[i] + 9;
+        } else if (strcmp(argv[i], "--fast-lexer") == 0) {
+            flags |= SERVER_FAST_LEXER;
+        } else if (strcmp(argv[i], "--token-array") == 0) {
+            flags |= SERVER_PRE_LEX;
+        } else if (strcmp(argv[i], "--compact") == 0) {
+            flags |= SERVER_COMPACT;
+        } else if (strcmp(argv[i], "--dot") == 0 || strcmp(argv[i], "--emit=dot") == 0) {
+            emit = cc_emit_dot;
+        } else if (strcmp(argv[i], "--emit=json") == 0) {
+            emit = cc_emit_json;
+        } else if (strcmp(argv[i], "--emit=binary") == 0) {
+            emit = cc_emit_binary;
+        } else if (strcmp(argv[i], "--stop") == 0) {
+            flags |= SERVER_STOP;
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 1;
+        }
+    }
+
+    /* the server has nothing to compile when stopping */
+    if ((flags & SERVER_STOP) != 0 && (flags != SERVER_STOP || path != NULL)) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 1;
+    }
+
+    cc_input_t* input = NULL;
+
+    if ((flags & SERVER_STOP) == 0) {
+        input = cc_open_input(path);
+
+        if (input == NULL) {
+            fprintf(stderr, "%s: could not read %s\n", argv[0], path != NULL ? path : "the standard input");
+            return 1;
+        }
+    }
+
+    int  ret = 0;
+    bool ok  = cc_ask_server(socket, flags, emit, input, &ret);
+
+    cc_close_input(input);
+
+    if (!ok) {
+        fprintf(stderr, "%s: could not get an answer from %s\n", argv[0], socket);
+        return 1;
+    }
+
+    return ret < 0 ? 1 : ret;
+}
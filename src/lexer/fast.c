@@ -0,0 +1,704 @@
+/** @file lexer/fast.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include "lexer/fast.h"
+#include "parser/context.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+#if defined(__AVX2__)
+
+#define CHUNK_SIZE 32
+
+typedef __m256i cc_chunk_t;
+
+#define cc_load_chunk(P)      _mm256_loadu_si256((__m256i const*)(P))
+#define cc_splat_chunk(C)     _mm256_set1_epi8(C)
+#define cc_eq_chunk(A, B)     _mm256_cmpeq_epi8(A, B)
+#define cc_gt_chunk(A, B)     _mm256_cmpgt_epi8(A, B)
+#define cc_or_chunk(A, B)     _mm256_or_si256(A, B)
+#define cc_and_chunk(A, B)    _mm256_and_si256(A, B)
+#define cc_mask_chunk(A)      ((uint32_t)_mm256_movemask_epi8(A))
+
+#elif defined(__SSE2__)
+
+#define CHUNK_SIZE 16
+
+typedef __m128i cc_chunk_t;
+
+#define cc_load_chunk(P)      _mm_loadu_si128((__m128i const*)(P))
+#define cc_splat_chunk(C)     _mm_set1_epi8(C)
+#define cc_eq_chunk(A, B)     _mm_cmpeq_epi8(A, B)
+#define cc_gt_chunk(A, B)     _mm_cmpgt_epi8(A, B)
+#define cc_or_chunk(A, B)     _mm_or_si128(A, B)
+#define cc_and_chunk(A, B)    _mm_and_si128(A, B)
+#define cc_mask_chunk(A)      ((uint32_t)_mm_movemask_epi8(A))
+
+#endif
+
+/* a mask with one bit per byte of a chunk */
+#define FULL_CHUNK_MASK ((uint32_t)((1ull << CHUNK_SIZE) - 1))
+
+/**
+ * Whether a character can be part of a word, i.e. `[[:alnum:]_]`.
+ *
+ * @param c the character.
+ *
+ * @return a boolean indicating so.
+ */
+static inline bool cc_is_word_fast(char c);
+
+/**
+ * Skips every blank (space or tab) character.
+ *
+ * @param p where to start.
+ * @param limit where the input ends.
+ *
+ * @return the first non-blank character, or `limit`.
+ */
+static inline char* cc_skip_blanks_fast(
+    char* p,
+    char* limit);
+
+/**
+ * Skips every character that can be part of a word.
+ *
+ * @param p where to start.
+ * @param limit where the input ends.
+ *
+ * @return the first character that can't, or `limit`.
+ */
+static inline char* cc_skip_word_fast(
+    char* p,
+    char* limit);
+
+/**
+ * Searches for the first of three characters.  Pass the same character
+ * more than once to search for fewer.
+ *
+ * @param p where to start.
+ * @param limit where the input ends.
+ * @param a a character to search for.
+ * @param b another one.
+ * @param c yet another one.
+ *
+ * @return the first occurrence of any of them, or `limit`.
+ */
+static inline char* cc_find_any_fast(
+    char* p,
+    char* limit,
+    char  a,
+    char  b,
+    char  c);
+
+/**
+ * Consumes `length` characters as a single match, updating the location
+ * and the column as `YY_USER_ACTION` does.
+ *
+ * @param context the compilation.
+ * @param length how many characters the match has.
+ */
+static inline void cc_match_fast(
+    cc_context_t* context,
+    size_t        length);
+
+/**
+ * Consumes a newline, marking where the next line starts.
+ *
+ * @param context the compilation.
+ */
+static inline void cc_newline_fast(cc_context_t* context);
+
+/**
+ * Creates the lexic value of the last match as the value of the token.
+ *
+ * @param context the compilation.
+ * @param data the data of the lexic value.
+ * @param kind the kind of the lexic value.
+ * @param type its type.
+ */
+static inline void cc_set_value_fast(
+    cc_context_t*       context,
+    cc_node_data_t      data,
+    cc_node_data_kind_t kind,
+    cc_type_t           type);
+
+/**
+ * Scans a block comment until its end or the end of the input.
+ *
+ * @param context the compilation.
+ *
+ * @return whether the comment was closed.
+ */
+static bool cc_scan_comment_fast(cc_context_t* context);
+
+/**
+ * Scans a word: a keyword, a boolean literal or an identifier.
+ *
+ * @param context the compilation.
+ *
+ * @return the token.
+ */
+static int cc_scan_word_fast(cc_context_t* context);
+
+/**
+ * Scans a number, be it an integer, a float or a malformed one.
+ *
+ * @param context the compilation.
+ *
+ * @return the token.
+ */
+static int cc_scan_number_fast(cc_context_t* context);
+
+/**
+ * Scans a string or character literal, or just its opening quote if the
+ * literal is malformed.
+ *
+ * @param context the compilation.
+ * @param quote the quote character that opened the literal.
+ *
+ * @return the token.
+ */
+static int cc_scan_quoted_fast(
+    cc_context_t* context,
+    char          quote);
+
+/**
+ * Scans a special character or a composite operator.
+ *
+ * @param context the compilation.
+ *
+ * @return the token.
+ */
+static int cc_scan_operator_fast(cc_context_t* context);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+bool cc_is_word_fast(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+char* cc_skip_blanks_fast(
+    char* p,
+    char* limit)
+{
+#ifdef CHUNK_SIZE
+    cc_chunk_t space = cc_splat_chunk(' ');
+    cc_chunk_t tab   = cc_splat_chunk('\t');
+
+    for (; limit - p >= CHUNK_SIZE; p += CHUNK_SIZE) {
+        cc_chunk_t chunk = cc_load_chunk(p);
+        uint32_t   mask  = ~cc_mask_chunk(cc_or_chunk(cc_eq_chunk(chunk, space), cc_eq_chunk(chunk, tab))) & FULL_CHUNK_MASK;
+
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+    }
+#endif
+
+    while (p < limit && (*p == ' ' || *p == '\t'))
+        p++;
+
+    return p;
+}
+
+char* cc_skip_word_fast(
+    char* p,
+    char* limit)
+{
+#ifdef CHUNK_SIZE
+    /* the comparisons are signed, so anything above 127 is never a word */
+    cc_chunk_t case_bit   = cc_splat_chunk(0x20);
+    cc_chunk_t before_a   = cc_splat_chunk('a' - 1);
+    cc_chunk_t after_z    = cc_splat_chunk('z' + 1);
+    cc_chunk_t before_0   = cc_splat_chunk('0' - 1);
+    cc_chunk_t after_9    = cc_splat_chunk('9' + 1);
+    cc_chunk_t underscore = cc_splat_chunk('_');
+
+    for (; limit - p >= CHUNK_SIZE; p += CHUNK_SIZE) {
+        cc_chunk_t chunk = cc_load_chunk(p);
+        cc_chunk_t lower = cc_or_chunk(chunk, case_bit);
+        cc_chunk_t alpha = cc_and_chunk(cc_gt_chunk(lower, before_a), cc_gt_chunk(after_z, lower));
+        cc_chunk_t digit = cc_and_chunk(cc_gt_chunk(chunk, before_0), cc_gt_chunk(after_9, chunk));
+        cc_chunk_t word  = cc_or_chunk(cc_or_chunk(alpha, digit), cc_eq_chunk(chunk, underscore));
+        uint32_t   mask  = ~cc_mask_chunk(word) & FULL_CHUNK_MASK;
+
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+    }
+#endif
+
+    while (p < limit && cc_is_word_fast(*p))
+        p++;
+
+    return p;
+}
+
+char* cc_find_any_fast(
+    char* p,
+    char* limit,
+    char  a,
+    char  b,
+    char  c)
+{
+#ifdef CHUNK_SIZE
+    cc_chunk_t first  = cc_splat_chunk(a);
+    cc_chunk_t second = cc_splat_chunk(b);
+    cc_chunk_t third  = cc_splat_chunk(c);
+
+    for (; limit - p >= CHUNK_SIZE; p += CHUNK_SIZE) {
+        cc_chunk_t chunk = cc_load_chunk(p);
+        cc_chunk_t found = cc_or_chunk(cc_eq_chunk(chunk, first), cc_or_chunk(cc_eq_chunk(chunk, second), cc_eq_chunk(chunk, third)));
+        uint32_t   mask  = cc_mask_chunk(found);
+
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+    }
+#endif
+
+    while (p < limit && *p != a && *p != b && *p != c)
+        p++;
+
+    return p;
+}
+
+void cc_match_fast(
+    cc_context_t* context,
+    size_t        length)
+{
+    cc_fast_lexer_t* lexer = &context->fast;
+
+    context->location.first_line   = context->location.last_line = context->line;
+    context->location.first_column = lexer->column;
+    context->location.last_column  = lexer->column + (int)length - 1;
+
+    lexer->column += (int)length;
+    lexer->cursor += length;
+
+    return;
+}
+
+void cc_newline_fast(cc_context_t* context)
+{
+    /* flex counts the line before running the action */
+    context->line++;
+    cc_match_fast(context, 1);
+    cc_mark_line_text_buffer(context, context->fast.cursor);
+    context->fast.column = 1;
+
+    return;
+}
+
+void cc_set_value_fast(
+    cc_context_t*       context,
+    cc_node_data_t      data,
+    cc_node_data_kind_t kind,
+    cc_type_t           type)
+{
+    context->fast.value->lexic_value = cc_create_lexic_value(context, data, kind, type, cc_match_location(context));
+
+    return;
+}
+
+bool cc_scan_comment_fast(cc_context_t* context)
+{
+    cc_fast_lexer_t* lexer = &context->fast;
+    char*            limit = lexer->limit;
+
+    while (lexer->cursor < limit) {
+        char* cursor = lexer->cursor;
+
+        if (*cursor == '\n') {
+            cc_newline_fast(context);
+        } else if (*cursor == '*') {
+            char* stars = cursor;
+
+            while (stars < limit && *stars == '*')
+                stars++;
+
+            if (stars < limit && *stars == '/') {
+                cc_match_fast(context, stars + 1 - cursor);
+                return true;
+            }
+
+            cc_match_fast(context, cc_find_any_fast(stars, limit, '*', '/', '\n') - cursor);
+        } else {
+            cc_match_fast(context, cc_find_any_fast(cursor, limit, '*', '\n', '\n') - cursor);
+        }
+    }
+
+    return false;
+}
+
+int cc_scan_word_fast(cc_context_t* context)
+{
+    cc_fast_lexer_t*    lexer   = &context->fast;
+    char*               start   = lexer->cursor;
+    size_t              length  = cc_skip_word_fast(start + 1, lexer->limit) - start;
+    cc_keyword_t const* keyword = cc_find_keyword(start, length);
+    cc_node_data_t      input;
+
+    cc_match_fast(context, length);
+
+    if (keyword == NULL) {
+        input.id = cc_intern_string(&context->pool, start, length);
+        cc_set_value_fast(context, input, cc_id, cc_type_undef);
+        return TK_IDENTIFICADOR;
+    }
+
+    switch (keyword->kind) {
+    case cc_keyword_type:
+        context->fast.value->type = (cc_type_t)keyword->value;
+        break;
+    case cc_keyword_command:
+        input.cmd = (cc_command_t)keyword->value;
+        cc_set_value_fast(context, input, cc_cmd, cc_type_undef);
+        break;
+    case cc_keyword_literal:
+        input.lit.boolean = (bool)keyword->value;
+        cc_set_value_fast(context, input, cc_lit, cc_type_bool);
+        break;
+    default:
+        break;
+    }
+
+    return keyword->token;
+}
+
+int cc_scan_number_fast(cc_context_t* context)
+{
+    char* limit  = context->fast.limit;
+    char* start  = context->fast.cursor;
+    char* digits = start;
+
+    while (digits < limit && *digits >= '0' && *digits <= '9')
+        digits++;
+
+    /* the longest of all number rules wins, the first one on ties */
+    size_t integer   = digits - start;
+    size_t word      = cc_skip_word_fast(digits, limit) - start;
+    size_t floating  = 0;
+    size_t malformed = 0;
+
+    if (digits + 1 < limit && digits[0] == '.' && cc_is_word_fast(digits[1])) {
+        char* end = digits + 1;
+
+        malformed = cc_skip_word_fast(end, limit) - start;
+
+        while (end < limit && *end >= '0' && *end <= '9')
+            end++;
+
+        if (end > digits + 1) {
+            char* exponent = end;
+
+            if (exponent < limit && (*exponent == 'e' || *exponent == 'E')) {
+                exponent++;
+
+                if (exponent < limit && (*exponent == '+' || *exponent == '-'))
+                    exponent++;
+
+                if (exponent < limit && *exponent >= '0' && *exponent <= '9') {
+                    while (exponent < limit && *exponent >= '0' && *exponent <= '9')
+                        exponent++;
+
+                    end = exponent;
+                }
+            }
+
+            floating = end - start;
+        }
+    }
+
+    size_t length = integer;
+    int    token  = TK_LIT_INT;
+
+    if (floating != 0 && floating >= malformed) {
+        length = floating;
+        token  = TK_LIT_FLOAT;
+    } else if (malformed != 0) {
+        length = malformed;
+        token  = TOKEN_ERRO;
+    } else if (word > integer) {
+        length = word;
+        token  = TOKEN_ERRO;
+    }
+
+    cc_match_fast(context, length);
+
+    if (token == TOKEN_ERRO)
+        return token;
+
+    /* the input is writable, so terminate the number in place as flex does */
+    char           hold = start[length];
+    cc_node_data_t input;
+
+    start[length] = '\0';
+
+    if (token == TK_LIT_FLOAT) {
+        input.lit.floating = atof(start);
+        cc_set_value_fast(context, input, cc_lit, cc_type_float);
+    } else {
+        input.lit.integer = atoi(start);
+        cc_set_value_fast(context, input, cc_lit, cc_type_int);
+    }
+
+    start[length] = hold;
+
+    return token;
+}
+
+int cc_scan_quoted_fast(
+    cc_context_t* context,
+    char          quote)
+{
+    char* limit = context->fast.limit;
+    char* start = context->fast.cursor;
+    char* end   = start + 1;
+    bool  valid = false;
+
+    if (quote == '"') {
+        /* any number of escapes or plain characters, up to the next quote */
+        for (;;) {
+            end = cc_find_any_fast(end, limit, '"', '\\', '\n');
+
+            if (end >= limit || *end == '\n')
+                break;
+
+            if (*end == '"') {
+                valid = true;
+                end++;
+                break;
+            }
+
+            if (end + 1 >= limit || end[1] == '\n')
+                break;
+
+            end += 2;
+        }
+    } else {
+        /* exactly one escape or plain character */
+        if (end < limit && *end == '\\' && end + 1 < limit && end[1] != '\n')
+            end += 2;
+        else if (end < limit && *end != '\'' && *end != '\n' && *end != '\\')
+            end += 1;
+        else
+            end = NULL;
+
+        if (end != NULL && end < limit && *end == '\'') {
+            valid = true;
+            end++;
+        }
+    }
+
+    /* a lone quote is caught by the catch-all rule */
+    if (!valid) {
+        cc_match_fast(context, 1);
+        return TOKEN_ERRO;
+    }
+
+    size_t         length = end - start;
+    cc_node_data_t input;
+
+    cc_match_fast(context, length);
+
+    if (quote == '"') {
+        input.lit.string = cc_text_unescape(cc_create_ast_string(context, start + 1, length - 2), length - 2);
+        cc_set_value_fast(context, input, cc_lit, cc_type_string);
+
+        return TK_LIT_STRING;
+    }
+
+    if (length > 3) {
+        char* escaped_char  = cc_text_convert_escapes(start + 1, 2);
+        input.lit.character = escaped_char[0];
+        cc_free(escaped_char);
+    } else {
+        input.lit.character = start[1];
+    }
+
+    cc_set_value_fast(context, input, cc_lit, cc_type_char);
+
+    return TK_LIT_CHAR;
+}
+
+int cc_scan_operator_fast(cc_context_t* context)
+{
+    char*          cursor = context->fast.cursor;
+    char           first  = cursor[0];
+    char           second = cursor + 1 < context->fast.limit ? cursor[1] : '\0';
+    cc_node_data_t input;
+
+    switch (first) {
+    case '<':
+        if (second == '=') {
+            cc_match_fast(context, 2);
+            return TK_OC_LE;
+        } else if (second == '<') {
+            cc_match_fast(context, 2);
+            input.cmd = cc_cmd_shift_left;
+            cc_set_value_fast(context, input, cc_cmd, cc_type_undef);
+            return TK_OC_SL;
+        }
+        break;
+    case '>':
+        if (second == '=') {
+            cc_match_fast(context, 2);
+            input.expr = cc_expr_log_ge;
+            cc_set_value_fast(context, input, cc_expr, cc_type_undef);
+            return TK_OC_GE;
+        } else if (second == '>') {
+            cc_match_fast(context, 2);
+            input.cmd = cc_cmd_shift_right;
+            cc_set_value_fast(context, input, cc_cmd, cc_type_undef);
+            return TK_OC_SR;
+        }
+        break;
+    case '=':
+        if (second == '=') {
+            cc_match_fast(context, 2);
+            input.expr = cc_expr_log_eq;
+            cc_set_value_fast(context, input, cc_expr, cc_type_undef);
+            return TK_OC_EQ;
+        }
+        break;
+    case '!':
+        if (second == '=') {
+            cc_match_fast(context, 2);
+            input.expr = cc_expr_log_ne;
+            cc_set_value_fast(context, input, cc_expr, cc_type_undef);
+            return TK_OC_NE;
+        }
+        break;
+    case '&':
+        if (second == '&') {
+            cc_match_fast(context, 2);
+            input.expr = cc_expr_log_and;
+            cc_set_value_fast(context, input, cc_expr, cc_type_undef);
+            return TK_OC_AND;
+        }
+        break;
+    case '|':
+        if (second == '|') {
+            cc_match_fast(context, 2);
+            input.expr = cc_expr_log_or;
+            cc_set_value_fast(context, input, cc_expr, cc_type_undef);
+            return TK_OC_OR;
+        }
+        break;
+    default:
+        break;
+    }
+
+    cc_match_fast(context, 1);
+
+    /* every punctuation character but these is special */
+    if (!ispunct((unsigned char)first) || strchr("'\"`_~\\", first) != NULL)
+        return TOKEN_ERRO;
+
+    return (int)first;
+}
+
+void cc_set_input_fast_lexer(
+    cc_context_t* context,
+    char*         text,
+    size_t        length)
+{
+    cc_fast_lexer_t* lexer = &context->fast;
+
+    lexer->text       = text;
+    lexer->cursor     = text;
+    lexer->limit      = text + length;
+    lexer->partial    = false;
+    lexer->column     = 1;
+    lexer->in_comment = false;
+    lexer->value      = NULL;
+
+    return;
+}
+
+void cc_extend_input_fast_lexer(
+    cc_context_t* context,
+    char*         text,
+    size_t        length,
+    bool          partial)
+{
+    cc_fast_lexer_t* lexer = &context->fast;
+
+    lexer->cursor  = text + (lexer->cursor - lexer->text);
+    lexer->text    = text;
+    lexer->limit   = text + length;
+    lexer->partial = partial;
+
+    return;
+}
+
+int cc_fast_lex(
+    YYSTYPE*      value,
+    cc_context_t* context)
+{
+    cc_fast_lexer_t* lexer = &context->fast;
+    char*            limit = lexer->limit;
+
+    lexer->value = value;
+
+    for (;;) {
+        if (lexer->in_comment) {
+            lexer->in_comment = !cc_scan_comment_fast(context);
+
+            /* an unterminated comment is an error, unless the rest of it
+             * is yet to come */
+            if (lexer->in_comment) {
+                if (lexer->partial)
+                    return 0;
+
+                lexer->in_comment = false;
+                return TOKEN_ERRO;
+            }
+        }
+
+        char* cursor = lexer->cursor;
+
+        if (cursor >= limit)
+            return 0;
+
+        char c = *cursor;
+
+        if (c == ' ' || c == '\t') {
+            cc_match_fast(context, cc_skip_blanks_fast(cursor, limit) - cursor);
+        } else if (c == '\n') {
+            cc_newline_fast(context);
+        } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+            return cc_scan_word_fast(context);
+        } else if (c >= '0' && c <= '9') {
+            return cc_scan_number_fast(context);
+        } else if (c == '"' || c == '\'') {
+            return cc_scan_quoted_fast(context, c);
+        } else if (c == '/' && cursor + 1 < limit && cursor[1] == '*') {
+            cc_match_fast(context, 2);
+            lexer->in_comment = true;
+        } else if (c == '/' && cursor + 1 < limit && cursor[1] == '/') {
+            cc_match_fast(context, cc_find_any_fast(cursor, limit, '\n', '\n', '\n') - cursor);
+            lexer->column = 1;
+        } else {
+            return cc_scan_operator_fast(context);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+/** @file lexer/input.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lexer/input.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Maps a regular file  to memory, privately and writable,  as flex puts
+ * null characters after each token while scanning. The mapping is padded
+ * with at least two zeroed characters after the end of the file.
+ *
+ * @param input the input to fill.
+ * @param fd the file descriptor of the file.
+ * @param length the size of the file.
+ *
+ * @return whether the mapping succeeded.
+ */
+static bool cc_map_input(
+    cc_input_t* input,
+    int         fd,
+    size_t      length);
+
+/**
+ * Reads a stream until its end into a heap buffer.
+ *
+ * @param input the input to fill.
+ * @param fd the file descriptor to read from.
+ *
+ * @return whether the reading succeeded.
+ */
+static bool cc_read_input(
+    cc_input_t* input,
+    int         fd);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+bool cc_map_input(
+    cc_input_t* input,
+    int         fd,
+    size_t      length)
+{
+    size_t page   = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapped = (length + 2 + page - 1) / page * page;
+
+    /* reserve zeroed memory first, so the padding exists even when the
+     * file ends exactly at the end of a page */
+    char* region = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (region == MAP_FAILED)
+        return false;
+
+    if (length > 0 && mmap(region, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(region, mapped);
+        return false;
+    }
+
+    input->text   = region;
+    input->length = length;
+    input->mapped = mapped;
+
+    return true;
+}
+
+bool cc_read_input(
+    cc_input_t* input,
+    int         fd)
+{
+    size_t  capacity = DEFAULT_INPUT_BUFFER_SIZE;
+    size_t  length   = 0;
+    char*   text     = (char*)cc_try_malloc(capacity, cc_mem_text);
+    ssize_t count;
+
+    do {
+        /* room for at least a character besides the two null ones */
+        if (capacity - length <= 2) {
+            capacity *= 2;
+            text      = (char*)cc_try_realloc(text, capacity, cc_mem_text);
+        }
+
+        count = read(fd, text + length, capacity - length - 2);
+
+        if (count > 0)
+            length += (size_t)count;
+    } while (count > 0 || (count < 0 && errno == EINTR));
+
+    /* reads cut short by a signal were tried again, anything else failed */
+    if (count < 0) {
+        cc_free(text);
+        return false;
+    }
+
+    text[length]     = '\0';
+    text[length + 1] = '\0';
+
+    input->text   = text;
+    input->length = length;
+    input->mapped = 0;
+
+    return true;
+}
+
+cc_input_t* cc_open_input(char const* path)
+{
+    int fd = path == NULL ? STDIN_FILENO : open(path, O_RDONLY);
+
+    if (fd < 0)
+        return NULL;
+
+    cc_input_t* input = (cc_input_t*)cc_try_malloc(sizeof(cc_input_t), cc_mem_text);
+    struct stat info;
+    bool        success;
+
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && cc_map_input(input, fd, (size_t)info.st_size))
+        success = true;
+    else
+        success = cc_read_input(input, fd);
+
+    if (path != NULL)
+        close(fd);
+
+    if (!success) {
+        cc_free(input);
+        return NULL;
+    }
+
+    return input;
+}
+
+cc_input_t* cc_create_input(size_t length)
+{
+    cc_input_t* input = (cc_input_t*)cc_try_malloc(sizeof(cc_input_t), cc_mem_text);
+
+    input->text   = (char*)cc_try_malloc(length + 2, cc_mem_text);
+    input->length = length;
+    input->mapped = 0;
+
+    input->text[length]     = '\0';
+    input->text[length + 1] = '\0';
+
+    return input;
+}
+
+void cc_close_input(cc_input_t* input)
+{
+    if (input == NULL)
+        return;
+
+    if (input->mapped != 0)
+        munmap(input->text, input->mapped);
+    else
+        cc_free(input->text);
+
+    cc_free(input);
+
+    return;
+}
@@ -0,0 +1,92 @@
+/** @file lexer/keywords.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include "lexer/keywords.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Hashes a word to its slot in the keyword table.  The coefficients were
+ * searched so that no two keywords share a slot; adding a keyword means
+ * checking that this still holds (and searching again if it doesn't).
+ *
+ * @param word the word to hash, at least one character long.
+ * @param length how many characters it has.
+ *
+ * @return an index between [0, KEYWORD_TABLE_SIZE).
+ */
+static inline uint32_t cc_hash_keyword(
+    char const* word,
+    size_t      length);
+
+/* every keyword, indexed by its hash */
+static cc_keyword_t const keyword_table[KEYWORD_TABLE_SIZE] = {
+    [ 0] = { "case",      4, TK_PR_CASE,      cc_keyword_plain,   0 },
+    [ 1] = { "char",      4, TK_PR_CHAR,      cc_keyword_type,    cc_type_char },
+    [ 2] = { "else",      4, TK_PR_ELSE,      cc_keyword_plain,   0 },
+    [ 8] = { "int",       3, TK_PR_INT,       cc_keyword_type,    cc_type_int },
+    [12] = { "false",     5, TK_LIT_FALSE,    cc_keyword_literal, false },
+    [14] = { "return",    6, TK_PR_RETURN,    cc_keyword_command, cc_cmd_return },
+    [15] = { "class",     5, TK_PR_CLASS,     cc_keyword_plain,   0 },
+    [17] = { "true",      4, TK_LIT_TRUE,     cc_keyword_literal, true },
+    [20] = { "const",     5, TK_PR_CONST,     cc_keyword_plain,   0 },
+    [21] = { "public",    6, TK_PR_PUBLIC,    cc_keyword_plain,   0 },
+    [23] = { "float",     5, TK_PR_FLOAT,     cc_keyword_type,    cc_type_float },
+    [24] = { "static",    6, TK_PR_STATIC,    cc_keyword_plain,   0 },
+    [26] = { "input",     5, TK_PR_INPUT,     cc_keyword_command, cc_cmd_input },
+    [29] = { "while",     5, TK_PR_WHILE,     cc_keyword_command, cc_cmd_while },
+    [33] = { "do",        2, TK_PR_DO,        cc_keyword_plain,   0 },
+    [34] = { "bool",      4, TK_PR_BOOL,      cc_keyword_type,    cc_type_bool },
+    [36] = { "continue",  8, TK_PR_CONTINUE,  cc_keyword_command, cc_cmd_continue },
+    [38] = { "break",     5, TK_PR_BREAK,     cc_keyword_command, cc_cmd_break },
+    [39] = { "default",   7, TK_PR_DEFAULT,   cc_keyword_plain,   0 },
+    [40] = { "private",   7, TK_PR_PRIVATE,   cc_keyword_plain,   0 },
+    [41] = { "output",    6, TK_PR_OUTPUT,    cc_keyword_command, cc_cmd_output },
+    [44] = { "string",    6, TK_PR_STRING,    cc_keyword_type,    cc_type_string },
+    [45] = { "foreach",   7, TK_PR_FOREACH,   cc_keyword_plain,   0 },
+    [49] = { "switch",    6, TK_PR_SWITCH,    cc_keyword_plain,   0 },
+    [52] = { "end",       3, TK_PR_END,       cc_keyword_plain,   0 },
+    [53] = { "protected", 9, TK_PR_PROTECTED, cc_keyword_plain,   0 },
+    [57] = { "if",        2, TK_PR_IF,        cc_keyword_command, cc_cmd_if },
+    [59] = { "for",       3, TK_PR_FOR,       cc_keyword_command, cc_cmd_for },
+    [62] = { "then",      4, TK_PR_THEN,      cc_keyword_plain,   0 },
+};
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+uint32_t cc_hash_keyword(
+    char const* word,
+    size_t      length)
+{
+    uint32_t first = (unsigned char)word[0];
+    uint32_t last  = (unsigned char)word[length - 1];
+
+    return (first + 5 * last + 9 * (uint32_t)length) & (KEYWORD_TABLE_SIZE - 1);
+}
+
+cc_keyword_t const* cc_find_keyword(
+    char const* word,
+    size_t      length)
+{
+    if (length == 0)
+        return NULL;
+
+    cc_keyword_t const* keyword = &keyword_table[cc_hash_keyword(word, length)];
+
+    if (keyword->name == NULL || keyword->length != length || memcmp(keyword->name, word, length) != 0)
+        return NULL;
+
+    return keyword;
+}
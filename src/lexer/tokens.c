@@ -0,0 +1,167 @@
+/** @file lexer/tokens.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include "lexer/tokens.h"
+#include "lexer/scanner.h"
+#include "parser/context.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Doubles the capacity of every per-token array.
+ *
+ * @param array the token array.
+ */
+static void cc_grow_token_array(cc_token_array_t* array);
+
+/**
+ * Appends the token just returned by the scanner, along with its location
+ * and, if it has one, its semantic value.
+ *
+ * @param array the token array.
+ * @param token the token.
+ * @param value the semantic value of the token.
+ * @param context the compilation.
+ */
+static void cc_push_token_array(
+    cc_token_array_t* array,
+    int               token,
+    YYSTYPE const*    value,
+    cc_context_t*     context);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_grow_token_array(cc_token_array_t* array)
+{
+    array->capacity *= 2;
+
+    array->kind   = (uint16_t*)cc_try_realloc(array->kind, array->capacity * sizeof(uint16_t), cc_mem_token);
+    array->line   = (uint32_t*)cc_try_realloc(array->line, array->capacity * sizeof(uint32_t), cc_mem_token);
+    array->column = (uint32_t*)cc_try_realloc(array->column, array->capacity * sizeof(uint32_t), cc_mem_token);
+    array->length = (uint32_t*)cc_try_realloc(array->length, array->capacity * sizeof(uint32_t), cc_mem_token);
+    array->value  = (uint32_t*)cc_try_realloc(array->value, array->capacity * sizeof(uint32_t), cc_mem_token);
+
+    return;
+}
+
+void cc_push_token_array(
+    cc_token_array_t* array,
+    int               token,
+    YYSTYPE const*    value,
+    cc_context_t*     context)
+{
+    if (array->count == array->capacity)
+        cc_grow_token_array(array);
+
+    uint32_t index = array->count++;
+
+    array->kind[index]   = (uint16_t)token;
+    array->line[index]   = (uint32_t)context->line;
+    array->column[index] = (uint32_t)context->location.first_column;
+    array->length[index] = (uint32_t)(context->location.last_column - context->location.first_column + 1);
+
+    if (!cc_has_lexic_value(token) && !(token >= TK_PR_INT && token <= TK_PR_STRING)) {
+        array->value[index] = NO_TOKEN_VALUE;
+        return;
+    }
+
+    if (array->value_count == array->value_capacity) {
+        array->value_capacity *= 2;
+        array->values = (YYSTYPE*)cc_try_realloc(array->values, array->value_capacity * sizeof(YYSTYPE), cc_mem_token);
+    }
+
+    array->value[index]                 = array->value_count;
+    array->values[array->value_count++] = *value;
+
+    return;
+}
+
+cc_token_array_t* cc_create_token_array(
+    cc_context_t*     context,
+    cc_input_t const* input)
+{
+    cc_token_array_t* array = (cc_token_array_t*)cc_try_malloc(sizeof(cc_token_array_t), cc_mem_token);
+
+    size_t   estimate = input->length / CHARS_PER_TOKEN;
+    uint32_t capacity = DEFAULT_TOKEN_ARRAY_SIZE;
+
+    if (estimate > capacity && estimate < UINT32_MAX / 2)
+        capacity = (uint32_t)estimate;
+
+    /* half the capacity, as growing doubles it right away */
+    array->capacity = capacity / 2;
+    array->kind     = NULL;
+    array->line     = NULL;
+    array->column   = NULL;
+    array->length   = NULL;
+    array->value    = NULL;
+    cc_grow_token_array(array);
+
+    array->count          = 0;
+    array->next           = 0;
+    array->value_count    = 0;
+    array->value_capacity = capacity / 4;
+    array->values         = (YYSTYPE*)cc_try_malloc(array->value_capacity * sizeof(YYSTYPE), cc_mem_token);
+
+    YYSTYPE value;
+    int     token;
+
+    /* the end of the input is stored as well, so the parser gets to see
+     * where the scanner stopped */
+    do {
+        token = cc_scan_token(&value, context);
+        cc_push_token_array(array, token, &value, context);
+    } while (token != 0);
+
+    return array;
+}
+
+int cc_next_token_array(
+    cc_token_array_t* array,
+    YYSTYPE*          value,
+    cc_context_t*     context)
+{
+    /* the last token is always the end of the input, which is repeated if
+     * the parser asks again */
+    uint32_t index = array->next < array->count - 1 ? array->next++ : array->count - 1;
+
+    YYLTYPE* location = &context->location;
+
+    context->line          = (int)array->line[index];
+    location->first_line   = location->last_line = (int)array->line[index];
+    location->first_column = (int)array->column[index];
+    location->last_column  = (int)(array->column[index] + array->length[index] - 1);
+
+    if (array->value[index] != NO_TOKEN_VALUE)
+        *value = array->values[array->value[index]];
+
+    return array->kind[index];
+}
+
+void cc_free_token_array(cc_token_array_t* array)
+{
+    if (array == NULL)
+        return;
+
+    cc_free(array->kind);
+    cc_free(array->line);
+    cc_free(array->column);
+    cc_free(array->length);
+    cc_free(array->value);
+    cc_free(array->values);
+    cc_free(array);
+
+    return;
+}
@@ -12,56 +12,192 @@
  */
 
 #include "lexer/tools.h"
+#include "parser/context.h"
 
 /* --------------------------------------------------------------------------- */
 /* Static declarations: */
 
-cc_list_t* yytextbuf = NULL;
+/**
+ * Prints a lexic value, its location and data.
+ *
+ * @param value the lexic value.
+ * @param stream were to print to.
+ */
+static void cc_print_lexic_value(
+    cc_lexic_value_t const* value,
+    FILE* restrict          stream);
 
 /* --------------------------------------------------------------------------- */
 /* Function definitions: */
 
-uint32_t cc_match_line(void)
+bool cc_has_lexic_value(int token)
+{
+    switch (token) {
+    case TK_PR_IF:
+    case TK_PR_WHILE:
+    case TK_PR_INPUT:
+    case TK_PR_OUTPUT:
+    case TK_PR_RETURN:
+    case TK_PR_FOR:
+    case TK_PR_BREAK:
+    case TK_PR_CONTINUE:
+    case TK_OC_GE:
+    case TK_OC_EQ:
+    case TK_OC_NE:
+    case TK_OC_AND:
+    case TK_OC_OR:
+    case TK_OC_SL:
+    case TK_OC_SR:
+    case TK_LIT_INT:
+    case TK_LIT_FLOAT:
+    case TK_LIT_FALSE:
+    case TK_LIT_TRUE:
+    case TK_LIT_CHAR:
+    case TK_LIT_STRING:
+    case TK_IDENTIFICADOR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void cc_print_lexic_value(
+    cc_lexic_value_t const* value,
+    FILE* restrict          stream)
+{
+    fprintf(stream, " @%u:%u+%u", value->location.line, value->location.column, value->location.length);
+
+    switch (value->kind) {
+    case cc_id:
+        fprintf(stream, " id %s", value->data.id);
+        break;
+    case cc_expr:
+        fprintf(stream, " expr %d", value->data.expr);
+        break;
+    case cc_cmd:
+        fprintf(stream, " cmd %d", value->data.cmd);
+        break;
+    case cc_lit:
+        switch (value->type) {
+        case cc_type_int:
+            fprintf(stream, " int %d", value->data.lit.integer);
+            break;
+        case cc_type_float:
+            fprintf(stream, " float %a", value->data.lit.floating);
+            break;
+        case cc_type_char:
+            fprintf(stream, " char %d", value->data.lit.character);
+            break;
+        case cc_type_bool:
+            fprintf(stream, " bool %d", value->data.lit.boolean);
+            break;
+        case cc_type_string:
+            fprintf(stream, " string \"%s\"", value->data.lit.string);
+            break;
+        default:
+            break;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return;
+}
+
+uint32_t cc_match_line(cc_context_t* context)
 {
-    return (uint32_t)yylineno;
+    return (uint32_t)context->line;
 }
 
-uint32_t cc_match_column(void)
+uint32_t cc_match_column(cc_context_t* context)
 {
-    return (uint32_t)yylloc.first_column;
+    return (uint32_t)context->location.first_column;
+}
+
+uint32_t cc_match_length(cc_context_t* context)
+{
+    return (uint32_t)(context->location.last_column - context->location.first_column);
+}
+
+cc_location_t cc_match_location(cc_context_t* context)
+{
+    return (cc_location_t) {cc_match_line(context), cc_match_column(context), cc_match_length(context)};
+}
+
+void cc_set_text_buffer(
+    cc_context_t* context,
+    char const*   text,
+    size_t        length)
+{
+    context->text.text       = text;
+    context->text.length     = length;
+    context->text.line_count = 0;
+
+    cc_mark_line_text_buffer(context, text);
+
+    return;
 }
 
-uint32_t cc_match_length(void)
+void cc_extend_text_buffer(
+    cc_context_t* context,
+    char const*   text,
+    size_t        length)
 {
-    return (uint32_t)(yylloc.last_column - yylloc.first_column);
+    context->text.text   = text;
+    context->text.length = length;
+
+    return;
 }
 
-cc_location_t cc_match_location(void)
+void cc_mark_line_text_buffer(
+    cc_context_t* context,
+    char const*   line)
 {
-    return (cc_location_t) {cc_match_line(), cc_match_column(), cc_match_length()};
+    cc_text_buffer_t* buffer = &context->text;
+
+    if (buffer->line_count == buffer->line_capacity) {
+        buffer->line_capacity = buffer->line_capacity == 0 ? DEFAULT_LINE_INDEX_SIZE : buffer->line_capacity * 2;
+        buffer->line_starts   = (size_t*)cc_try_realloc(buffer->line_starts, buffer->line_capacity * sizeof(size_t), cc_mem_text);
+    }
+
+    buffer->line_starts[buffer->line_count++] = (size_t)(line - buffer->text);
+
+    return;
 }
 
-void cc_update_text_buffer(
-    char* text,
-    size_t match_length)
+void cc_free_text_buffer(cc_context_t* context)
 {
-    if (yytextbuf == NULL)
-        yytextbuf = cc_create_list(&free);
+    cc_free(context->text.line_starts);
 
-    cc_insert_list(yytextbuf, strndup(text, match_length));
+    context->text = (cc_text_buffer_t) { NULL, 0, NULL, 0, 0 };
 
     return;
 }
 
 void cc_print_location(
+    cc_context_t*  context,
     cc_location_t  location,
     FILE* restrict stream)
 {
-    if (location.line > yytextbuf->size)
+    cc_text_buffer_t const* buffer = &context->text;
+
+    if (location.line == 0 || location.line > buffer->line_count)
         return;
 
-    char const* line = cc_access_list(yytextbuf, location.line);
-    uint16_t size    = strlen(line);
+    size_t start = buffer->line_starts[location.line - 1];
+    size_t end   = start;
+
+    /* the line being scanned hasn't got a successor yet, and flex may have
+     * put a null character where its newline was */
+    if (location.line < buffer->line_count)
+        end = buffer->line_starts[location.line] - 1;
+    else
+        while (end < buffer->length && buffer->text[end] != '\n' && buffer->text[end] != '\0')
+            end++;
+
+    char const* line = buffer->text + start;
+    uint16_t size    = end - start;
 
     if (location.column > size)
         return;
@@ -69,10 +205,32 @@ void cc_print_location(
     fprintf(stream, "%d:%d: appeared here:", location.line, location.column);
 
     fputs("\n    | ", stream);
-    fputs(line, stream);
+    fwrite(line, sizeof(char), size, stream);
     fputs("\n    | ", stream);
-    cc_text_underline(size + 1, location.column, location.column + location.length);
-    fputs("\n", stdout);
+    cc_text_underline(size + 1, location.column, location.column + location.length, stream);
+    fputs("\n", stream);
+
+    return;
+}
+
+void cc_print_tokens(
+    cc_context_t*  context,
+    FILE* restrict stream)
+{
+    YYSTYPE value;
+    YYLTYPE location;
+    int     token;
+
+    while ((token = yylex(&value, &location, context)) != 0) {
+        fprintf(stream, "%d:%d-%d %d", location.first_line, location.first_column, location.last_column, token);
+
+        if (token >= TK_PR_INT && token <= TK_PR_STRING)
+            fprintf(stream, " type %d", value.type);
+        else if (cc_has_lexic_value(token))
+            cc_print_lexic_value(value.lexic_value, stream);
+
+        fputc('\n', stream);
+    }
 
     return;
 }
@@ -11,21 +11,361 @@
  * 'LICENSE', which is part of this source code package.
  */
 
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
-extern int yyparse(void);
-extern int yylex_destroy(void);
+#include "lexer/input.h"
+#include "lexer/scanner.h"
+#include "lexer/tokens.h"
+#include "lexer/tools.h"
+#include "ast/binary.h"
+#include "ast/compact.h"
+#include "ast/print.h"
+#include "parser/context.h"
+#include "parser/driver.h"
+#include "parser/server.h"
+#include "parser/stream.h"
+#include "utils/memory.h"
+#include "utils/output.h"
+
+#define USAGE "usage: %s [--mem-report] [--fast-lexer] [--token-array] [--tokens] [--stream] [--compact] [--dot] [--emit=dot|json|binary] [--load] [-j threads] [--serve[=socket]] [file...]\n"
+
+/* how much is read at once when streaming */
+#define STREAM_CHUNK_SIZE ((size_t)65536)
 
 void* arvore = NULL;
 void exporta(void* arvore);
 void libera(void* arvore);
 
-int main(void)
+/**
+ * Parses the given file, or the standard input, as it's read, instead of
+ * waiting for all of it.
+ *
+ * @param context the compilation.
+ * @param path the path of the source file, or `NULL` for the standard
+ *             input.
+ *
+ * @return the result of parsing, or -1 if the input couldn't be read.
+ */
+static int cc_parse_stream(
+    cc_context_t* context,
+    char const*   path);
+
+/**
+ * Exports the tree of a context, or its compact version.
+ *
+ * @param context the compilation, whose tree is freed once made compact.
+ * @param compact whether to make a compact tree out of it first.
+ * @param emit what to export it as.
+ */
+static void cc_export_ast(
+    cc_context_t* context,
+    bool          compact,
+    cc_emit_t     emit);
+
+/**
+ * Exports a compact tree.
+ *
+ * @param ast the compact tree.
+ * @param emit what to export it as, anything but JSON.
+ */
+static void cc_export_compact_ast(
+    cc_compact_ast_t const* ast,
+    cc_emit_t               emit);
+
+/**
+ * Exports a tree loaded from a binary tree file instead of parsed.
+ *
+ * @param path the path of the file, or `NULL` for the standard input.
+ * @param emit what to export it as, anything but JSON.
+ *
+ * @return whether the file could be read and was sound.
+ */
+static bool cc_export_binary_ast(
+    char const* path,
+    cc_emit_t   emit);
+
+int cc_parse_stream(
+    cc_context_t* context,
+    char const*   path)
+{
+    int fd = path != NULL ? open(path, O_RDONLY) : STDIN_FILENO;
+
+    if (fd < 0)
+        return -1;
+
+    cc_stream_t* stream = cc_create_stream(context);
+    char         chunk[STREAM_CHUNK_SIZE];
+    ssize_t      length;
+    int          ret = YYPUSH_MORE;
+
+    while (ret == YYPUSH_MORE && (length = read(fd, chunk, sizeof(chunk))) > 0)
+        ret = cc_feed_stream(stream, chunk, (size_t)length);
+
+    if (ret == YYPUSH_MORE)
+        ret = length < 0 ? -1 : cc_finish_stream(stream);
+
+    cc_free_stream(stream);
+
+    if (fd != STDIN_FILENO)
+        close(fd);
+
+    return ret;
+}
+
+void cc_export_ast(
+    cc_context_t* context,
+    bool          compact,
+    cc_emit_t     emit)
+{
+    if (emit == cc_emit_default && !compact) {
+        exporta(context->ast);
+        return;
+    }
+
+    if (emit == cc_emit_default) {
+        cc_compact_ast_t* tree = cc_take_compact_ast(context);
+
+        cc_print_compact_ast(tree, tree->root);
+        cc_free_compact_ast(tree);
+        return;
+    }
+
+    cc_output_t output;
+
+    /* the output goes around stdio, which must be empty by then */
+    fflush(stdout);
+    cc_init_output(&output, STDOUT_FILENO);
+    cc_write_ast(&output, context, compact, emit);
+    cc_free_output(&output);
+
+    return;
+}
+
+void cc_export_compact_ast(
+    cc_compact_ast_t const* ast,
+    cc_emit_t               emit)
+{
+    if (emit == cc_emit_default) {
+        cc_print_compact_ast(ast, ast->root);
+        return;
+    }
+
+    cc_output_t output;
+
+    fflush(stdout);
+    cc_init_output(&output, STDOUT_FILENO);
+    cc_write_compact_ast(&output, ast, emit);
+    cc_free_output(&output);
+
+    return;
+}
+
+bool cc_export_binary_ast(
+    char const* path,
+    cc_emit_t   emit)
 {
-    int ret = yyparse();
-    exporta(arvore);
+    cc_binary_ast_t* binary = cc_open_binary_ast(path);
+
+    if (binary == NULL)
+        return false;
+
+    cc_compact_ast_t* tree = cc_load_compact_ast(binary);
+
+    if (tree != NULL)
+        cc_export_compact_ast(tree, emit);
+
+    cc_free_compact_ast(tree);
+    cc_close_binary_ast(binary);
+
+    return tree != NULL;
+}
+
+int main(int argc, char** argv)
+{
+    bool        mem_report = false;
+    bool        fast_lexer = false;
+    bool        pre_lex    = false;
+    bool        tokens     = false;
+    bool        streaming  = false;
+    bool        compact    = false;
+    bool        load       = false;
+    cc_emit_t   emit       = cc_emit_default;
+    long        threads    = sysconf(_SC_NPROCESSORS_ONLN);
+    char const* serve      = NULL;
+    char const* paths[argc];
+    uint32_t    count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mem-report") == 0) {
+            mem_report = true;
+        } else if (strcmp(argv[i], "--fast-lexer") == 0) {
+            fast_lexer = true;
+        } else if (strcmp(argv[i], "--token-array") == 0) {
+            pre_lex = true;
+        } else if (strcmp(argv[i], "--tokens") == 0) {
+            tokens = true;
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            streaming = true;
+        } else if (strcmp(argv[i], "--compact") == 0) {
+            compact = true;
+        } else if (strcmp(argv[i], "--dot") == 0 || strcmp(argv[i], "--emit=dot") == 0) {
+            emit = cc_emit_dot;
+        } else if (strcmp(argv[i], "--emit=json") == 0) {
+            emit = cc_emit_json;
+        } else if (strcmp(argv[i], "--emit=binary") == 0) {
+            emit = cc_emit_binary;
+        } else if (strcmp(argv[i], "--load") == 0) {
+            load = true;
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            serve = DEFAULT_SERVER_PATH;
+        } else if (strncmp(argv[i], "--serve=", 8) == 0) {
+            serve = argv[i] + 8;
+        } else if (strncmp(argv[i], "-j", 2) == 0) {
+            char const* number = argv[i][2] != '\0' ? argv[i] + 2 : i + 1 < argc ? argv[++i] : "";
+            char*       end;
+
+            threads = strtol(number, &end, 10);
+
+            if (*number == '\0' || *end != '\0' || threads < 1) {
+                fprintf(stderr, USAGE, argv[0]);
+                return 1;
+            }
+        } else if (argv[i][0] != '-') {
+            paths[count++] = argv[i];
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 1;
+        }
+    }
+
+    /* tokens are pushed to the parser as soon as they're scanned, so
+     * there's nothing to print or store beforehand, JSON is only written
+     * from the whole tree, along with its symbols, and loaded trees are
+     * compact ones, with nothing to scan */
+    bool json_compact = emit == cc_emit_json && (compact || load);
+    bool many         = count > 1;
+
+    if ((streaming && (tokens || pre_lex)) || json_compact || (load && (streaming || tokens || pre_lex))) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 1;
+    }
+
+    /* many inputs are compiled by the driver, each one on its own, only
+     * the trees they get to are written */
+    if (many && (streaming || tokens || load)) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 1;
+    }
+
+    /* the server is given its inputs by clients, and how to compile them */
+    if (serve != NULL && (count > 0 || fast_lexer || streaming || tokens || pre_lex || compact || load || emit != cc_emit_default)) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 1;
+    }
+
+    if (serve != NULL) {
+        int ret = cc_serve(serve);
+
+        if (ret < 0)
+            fprintf(stderr, "%s: could not listen on %s\n", argv[0], serve);
+
+        if (mem_report)
+            cc_print_memory_report(stderr);
+
+        return ret < 0 ? 1 : 0;
+    }
+
+    if (many) {
+        cc_driver_options_t options = {
+            .fast_lexer = fast_lexer,
+            .pre_lex    = pre_lex,
+            .compact    = compact,
+            .emit       = emit,
+        };
+
+        int ret = cc_compile_inputs(paths, count, threads > 0 ? (uint32_t)threads : 1, &options);
+
+        if (mem_report)
+            cc_print_memory_report(stderr);
+
+        return ret < 0 ? 1 : ret;
+    }
+
+    char const* path = count > 0 ? paths[0] : NULL;
+
+    if (load) {
+        if (!cc_export_binary_ast(path, emit)) {
+            fprintf(stderr, "%s: could not load a tree from %s\n", argv[0], path != NULL ? path : "the standard input");
+            return 1;
+        }
+
+        if (mem_report)
+            cc_print_memory_report(stderr);
+
+        return 0;
+    }
+
+    if (streaming) {
+        cc_context_t* context = cc_create_context();
+        int           ret     = cc_parse_stream(context, path);
+
+        if (ret < 0) {
+            fprintf(stderr, "%s: could not read %s\n", argv[0], path != NULL ? path : "the standard input");
+            cc_free_context(context);
+            return 1;
+        }
+
+        arvore = context->ast;
+        cc_export_ast(context, compact, emit);
+        libera(arvore);
+        arvore = NULL;
+        cc_free_context(context);
+
+        if (mem_report)
+            cc_print_memory_report(stderr);
+
+        return ret;
+    }
+
+    cc_input_t*   input   = cc_open_input(path);
+    cc_context_t* context = cc_create_context();
+
+    context->fast_lexer = fast_lexer;
+
+    if (input == NULL || !cc_scan_input(context, input)) {
+        fprintf(stderr, "%s: could not read %s\n", argv[0], path != NULL ? path : "the standard input");
+        cc_free_context(context);
+        cc_close_input(input);
+        return 1;
+    }
+
+    /* scan everything first, then feed the parser from the array */
+    if (pre_lex)
+        context->tokens = cc_create_token_array(context, input);
+
+    int ret = 0;
+
+    if (tokens) {
+        cc_print_tokens(context, stdout);
+    } else {
+        ret = yyparse(context);
+        arvore = context->ast;
+        cc_export_ast(context, compact, emit);
+    }
+
     libera(arvore);
     arvore = NULL;
-    yylex_destroy();
+    cc_free_context(context);
+    cc_close_input(input);
+
+    if (mem_report)
+        cc_print_memory_report(stderr);
+
     return ret;
 }
@@ -0,0 +1,73 @@
+/** @file parser/context.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include "parser/context.h"
+#include "lexer/scanner.h"
+#include "semantics/scope.h"
+#include "semantics/values.h"
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+cc_context_t* cc_create_context(void)
+{
+    cc_context_t* context = (cc_context_t*)cc_try_calloc(1, sizeof(cc_context_t), cc_mem_misc);
+
+    context->line        = 1;
+    context->diagnostics = stderr;
+
+    return context;
+}
+
+void cc_free_context(cc_context_t* context)
+{
+    if (context == NULL)
+        return;
+
+    /* the scopes refer to interned names and symbols, so they go first */
+    cc_free_scope(context);
+    cc_free_symbols(context);
+    cc_free_ast(context);
+    cc_free_interned_strings(&context->pool);
+    cc_free_token_array(context->tokens);
+    cc_free_text_buffer(context);
+    cc_free_scanner(context);
+    cc_free(context);
+
+    return;
+}
+
+void cc_reset_context(cc_context_t* context)
+{
+    cc_free_scope(context);
+    cc_reset_symbols(context);
+    cc_reset_arena(context->ast_arena);
+
+    /* the names are all that's left of the previous input, which only
+     * matters if there are too many of them */
+    if (context->pool.count > MAX_KEPT_INTERNED_STRINGS)
+        cc_free_interned_strings(&context->pool);
+
+    cc_free_token_array(context->tokens);
+    cc_free_scanner(context);
+
+    context->tokens          = NULL;
+    context->location        = (YYLTYPE) { 0 };
+    context->line            = 1;
+    context->ast             = NULL;
+    context->text.text       = NULL;
+    context->text.length     = 0;
+    context->text.line_count = 0;
+
+    return;
+}
@@ -0,0 +1,302 @@
+/** @file parser/driver.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "parser/driver.h"
+#include "ast/binary.h"
+#include "ast/dot.h"
+#include "ast/json.h"
+#include "lexer/input.h"
+#include "lexer/scanner.h"
+#include "lexer/tokens.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/* an input to compile, and what came out of it */
+typedef struct {
+    char const* path;               /** The path of the input. */
+    int         result;             /** What `cc_compile_input` returned. */
+    cc_output_t output;             /** Its tree. */
+    char*       diagnostics;        /** Its errors, allocated by the C library. */
+    size_t      diagnostics_length; /** How many characters of errors there are. */
+    bool        done;               /** Whether it was compiled already. */
+} cc_job_t;
+
+/* inputs shared by a pool of threads */
+typedef struct {
+    cc_job_t*                  jobs;     /** Every input. */
+    uint32_t                   count;    /** How many there are. */
+    uint32_t                   next;     /** The next one to be taken by a thread. */
+    size_t                     pending;  /** Bytes of finished output not written yet. */
+    size_t                     budget;   /** How many may be pending before threads wait. */
+    cc_driver_options_t const* options;  /** How to compile them. */
+    pthread_mutex_t            lock;     /** Guards everything above but `jobs`, and each `done`. */
+    pthread_cond_t             finished; /** Signaled whenever a job is done. */
+    pthread_cond_t             written;  /** Signaled whenever a job is written. */
+} cc_pool_t;
+
+/**
+ * Compiles a job into memory.
+ *
+ * @param job the job.
+ * @param options how to compile it.
+ */
+static void cc_run_job(
+    cc_job_t*                  job,
+    cc_driver_options_t const* options);
+
+/**
+ * Takes jobs from a pool and runs them, until there are none left.
+ *
+ * @param data the pool.
+ *
+ * @return nothing.
+ */
+static void* cc_work_pool(void* data);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_run_job(
+    cc_job_t*                  job,
+    cc_driver_options_t const* options)
+{
+    cc_init_output(&job->output, NO_OUTPUT_FD);
+
+    FILE* diagnostics = open_memstream(&job->diagnostics, &job->diagnostics_length);
+
+    /* without memory for the errors, they're just not in order */
+    if (diagnostics == NULL) {
+        job->diagnostics = NULL;
+        diagnostics      = stderr;
+    }
+
+    job->result = cc_compile_input(job->path, &job->output, diagnostics, options);
+
+    if (job->result < 0)
+        fprintf(diagnostics, "could not read %s\n", job->path);
+
+    if (diagnostics != stderr)
+        fclose(diagnostics);
+
+    return;
+}
+
+void* cc_work_pool(void* data)
+{
+    cc_pool_t* pool = (cc_pool_t*)data;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+
+        /* whatever is pending comes after the job being waited for, which
+         * was taken already, so the wait always ends */
+        while (pool->next < pool->count && pool->pending > pool->budget)
+            pthread_cond_wait(&pool->written, &pool->lock);
+
+        uint32_t index = pool->next < pool->count ? pool->next++ : pool->count;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (index == pool->count)
+            break;
+
+        cc_job_t* job = &pool->jobs[index];
+
+        cc_run_job(job, pool->options);
+
+        pthread_mutex_lock(&pool->lock);
+        job->done      = true;
+        pool->pending += job->output.length + job->diagnostics_length;
+        pthread_cond_broadcast(&pool->finished);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+bool cc_write_ast(
+    cc_output_t*  output,
+    cc_context_t* context,
+    bool          compact,
+    cc_emit_t     emit)
+{
+    if (emit == cc_emit_json)
+        return cc_write_json_ast(output, context->ast);
+
+    if (!compact && emit != cc_emit_binary) {
+        cc_dot_writer_t* writer = cc_create_dot_writer(output);
+        bool             ret    = cc_write_dot_ast(writer, context->ast);
+
+        cc_free_dot_writer(writer);
+
+        return ret;
+    }
+
+    cc_compact_ast_t* tree = cc_take_compact_ast(context);
+    bool              ret  = cc_write_compact_ast(output, tree, emit);
+
+    cc_free_compact_ast(tree);
+
+    return ret;
+}
+
+bool cc_write_compact_ast(
+    cc_output_t*            output,
+    cc_compact_ast_t const* ast,
+    cc_emit_t               emit)
+{
+    if (emit == cc_emit_binary)
+        return cc_write_binary_ast(output, ast);
+
+    cc_dot_writer_t* writer = cc_create_dot_writer(output);
+    bool             ret    = cc_write_dot_compact_ast(writer, ast, ast->root);
+
+    cc_free_dot_writer(writer);
+
+    return ret;
+}
+
+int cc_compile_context(
+    cc_context_t*              context,
+    cc_input_t*                input,
+    cc_output_t*               output,
+    cc_driver_options_t const* options)
+{
+    context->fast_lexer = options->fast_lexer;
+
+    if (!cc_scan_input(context, input))
+        return -1;
+
+    if (options->pre_lex)
+        context->tokens = cc_create_token_array(context, input);
+
+    int ret = yyparse(context);
+
+    cc_write_ast(output, context, options->compact, options->emit);
+
+    return ret;
+}
+
+int cc_compile_input(
+    char const*                path,
+    cc_output_t*               output,
+    FILE*                      diagnostics,
+    cc_driver_options_t const* options)
+{
+    cc_input_t* input = cc_open_input(path);
+
+    if (input == NULL)
+        return -1;
+
+    cc_context_t* context = cc_create_context();
+
+    context->diagnostics = diagnostics;
+
+    int ret = cc_compile_context(context, input, output, options);
+
+    cc_free_context(context);
+    cc_close_input(input);
+
+    return ret;
+}
+
+int cc_compile_inputs(
+    char const* const*         paths,
+    uint32_t                   count,
+    uint32_t                   threads,
+    cc_driver_options_t const* options)
+{
+    cc_pool_t pool = {
+        .jobs    = (cc_job_t*)cc_try_calloc(count, sizeof(cc_job_t), cc_mem_misc),
+        .count   = count,
+        .next    = 0,
+        .pending = 0,
+        .options = options,
+    };
+
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.finished, NULL);
+    pthread_cond_init(&pool.written, NULL);
+
+    for (uint32_t i = 0; i < count; i++)
+        pool.jobs[i].path = paths[i];
+
+    if (threads > count)
+        threads = count;
+
+    pthread_t* workers = (pthread_t*)cc_try_malloc((threads > 0 ? threads : 1) * sizeof(pthread_t), cc_mem_misc);
+    uint32_t   started = 0;
+
+    pool.budget = (threads > 0 ? threads : 1) * DRIVER_PENDING_OUTPUT_SIZE;
+
+    while (started < threads && pthread_create(&workers[started], NULL, cc_work_pool, &pool) == 0)
+        started++;
+
+    /* without any thread, everything is compiled right here, before
+     * anything is written */
+    if (started == 0) {
+        pool.budget = SIZE_MAX;
+        cc_work_pool(&pool);
+    }
+
+    cc_output_t output;
+    int         ret = 0;
+
+    cc_init_output(&output, STDOUT_FILENO);
+
+    for (uint32_t i = 0; i < count; i++) {
+        cc_job_t* job = &pool.jobs[i];
+
+        pthread_mutex_lock(&pool.lock);
+
+        while (!job->done)
+            pthread_cond_wait(&pool.finished, &pool.lock);
+
+        pthread_mutex_unlock(&pool.lock);
+
+        if (job->diagnostics_length > 0) {
+            fprintf(stderr, "%s:\n", job->path);
+            fwrite(job->diagnostics, sizeof(char), job->diagnostics_length, stderr);
+        }
+
+        cc_put_output(&output, job->output.buffer, job->output.length);
+        cc_flush_output(&output);
+
+        if (ret == 0 && job->result != 0)
+            ret = job->result;
+
+        pthread_mutex_lock(&pool.lock);
+        pool.pending -= job->output.length + job->diagnostics_length;
+        pthread_cond_broadcast(&pool.written);
+        pthread_mutex_unlock(&pool.lock);
+
+        cc_free_output(&job->output);
+        free(job->diagnostics);
+    }
+
+    for (uint32_t i = 0; i < started; i++)
+        pthread_join(workers[i], NULL);
+
+    cc_free_output(&output);
+    cc_free(workers);
+    cc_free(pool.jobs);
+    pthread_cond_destroy(&pool.written);
+    pthread_cond_destroy(&pool.finished);
+    pthread_mutex_destroy(&pool.lock);
+
+    return ret;
+}
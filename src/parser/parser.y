@@ -15,11 +15,13 @@
 }
 
 %code {
+#include "parser/context.h"
 #include "parser/parser.h"
 }
 
 %union {
     cc_ast_t*         node;
+    cc_ast_chain_t    chain;
     cc_lexic_value_t* lexic_value;
     cc_list_t*        list;
     cc_symb_pair_t*   pair;
@@ -75,12 +77,16 @@
 %token <lexic_value> TK_IDENTIFICADOR
 %token TOKEN_ERRO
 
-%type <node> source function
+%type <chain> source
+%type <node> function
 %type <lexic_value> header
 
-%type <node> command command_rep
+%type <chain> command
+%type <chain> command_rep
 %type <node> atrib
-%type <node> var_local id_var_local_rep id_var_local
+%type <chain> var_local
+%type <node> id_var_local
+%type <chain> id_var_local_rep
 %type <node> control_flow
 %type <node> if
 %type <node> for
@@ -88,12 +94,12 @@
 %type <node> io
 %type <node> shift
 %type <node> return
-%type <node> call param_rep
-%type <node> block func_block
+%type <node> call
+%type <chain> param_rep
+%type <chain> block
+%type <node> func_block
 
 %type <node> expr
-%type <node> op_tern op_log op_bws op_eq op_cmp
-%type <node> op_add op_mul op_exp op_un op_elem
 %type <node> id_index id
 
 %type <lexic_value> tk_op_eq tk_op_log tk_op_cmp tk_op_add
@@ -112,11 +118,38 @@
 
 %type <expr> signal
 
+/* lists and pairs are owned by the parser until an action takes them,
+ * so the ones left behind by a syntax error must be freed here, or a
+ * server would leak them with every such input */
+%destructor { cc_free_list($$); } <list>
+%destructor { cc_free_symbol_pair($$); } <pair>
+
+/* operators, from the loosest to the tightest binding, so expressions
+ * don't need a rule for each level */
+%right '?' ':'
+%left TK_OC_AND TK_OC_OR
+%left '|' '&'
+%left TK_OC_EQ TK_OC_NE
+%left TK_OC_LE TK_OC_GE '<' '>'
+%left '+' '-'
+%left '*' '/' '%'
+%left '^'
+%precedence UNARY
+
 /* the following options enable us more information when printing the
  * error */
 %define parse.error verbose
 %locations
 
+/* no global state, everything of a compilation lives in its context, which
+ * is handed to both the parser and the scanner */
+%define api.pure full
+%param {cc_context_t* context}
+
+/* besides pulling tokens with `yyparse`, they can be pushed one at a time
+ * as the input arrives, see "parser/stream.h" */
+%define api.push-pull both
+
 /* explicitly define the starting state as source */
 %start source
 
@@ -126,9 +159,9 @@
 
     /* the source code can be empty, and variables require ; */
 source
-    : %empty                { $$ = NULL; }
-    | source var_global ';' { $$ = $1; cc_add_list_scope($2); }
-    | source function       { $$ = cc_set_next_ast_node($1, $2); cc_update_global_ast($$); }
+    : %empty                { $$ = cc_create_ast_chain(NULL); }
+    | source var_global ';' { $$ = $1; cc_add_list_scope(context, $2); cc_free_list($2); }
+    | source function       { $$ = cc_append_ast_chain($1, $2); cc_update_global_ast(context, $$.head); }
     ;
 
 var_global
@@ -146,18 +179,18 @@ id_var_global_rep
 
 id_var_global
     : TK_IDENTIFICADOR '[' TK_LIT_INT ']' {
-        $$ = cc_create_symbol_pair($1, cc_symb_array);
+        $$ = cc_create_symbol_pair(context, $1, cc_symb_array);
         cc_init_array_symbol($$->symbol, $3);
     }
     | TK_IDENTIFICADOR                    {
-        $$ = cc_create_symbol_pair($1, cc_symb_var);
+        $$ = cc_create_symbol_pair(context, $1, cc_symb_var);
     }
     ;
 
 function
     : header func_block {
         $1->kind = cc_func;
-        $$ = cc_create_ast_node($1, NULL, $2, NULL);
+        $$ = cc_create_unary_ast_node(context, $1, $2);
     }
     ;
 
@@ -165,16 +198,16 @@ function
 header
     : header_id header_params {
         $$ = $1->symbol->optional_info.temp_value;
-        cc_init_func_symbol($1->symbol, $2);
-        cc_add_pair_scope($1);
-        cc_push_new_scope();
-        cc_add_list_scope($2);
+        cc_init_func_symbol(context, $1->symbol, $2);
+        cc_add_pair_scope(context, $1);
+        cc_push_new_scope(context);
+        cc_add_list_scope(context, $2);
     }
     ;
 
 header_id
-    : type TK_IDENTIFICADOR              { $$ = cc_create_symbol_pair($2, cc_symb_func); }
-    | TK_PR_STATIC type TK_IDENTIFICADOR { $$ = cc_create_symbol_pair($3, cc_symb_func); }
+    : type TK_IDENTIFICADOR              { $$ = cc_create_symbol_pair(context, $2, cc_symb_func); }
+    | TK_PR_STATIC type TK_IDENTIFICADOR { $$ = cc_create_symbol_pair(context, $3, cc_symb_func); }
     ;
 
 header_params
@@ -190,57 +223,59 @@ def_params_rep
     ;
 
 def_params
-    : type TK_IDENTIFICADOR              { $$ = cc_create_symbol_pair($2, cc_symb_var); }
-    | TK_PR_CONST type TK_IDENTIFICADOR  { $$ = cc_create_symbol_pair($3, cc_symb_var); }
+    : type TK_IDENTIFICADOR              { $$ = cc_create_symbol_pair(context, $2, cc_symb_var); }
+    | TK_PR_CONST type TK_IDENTIFICADOR  { $$ = cc_create_symbol_pair(context, $3, cc_symb_var); }
     ;
 
 func_block
     : '{' '}'                            { $$ = NULL; }
-    | '{' command_rep close_scope        { $$ = $2; }
+    | '{' command_rep close_scope        { $$ = $2.head; }
     ;
 
     /* ---------- COMMANDS ---------- */
 
     /* commands are chained through ; */
 command_rep
-    : command_rep command ';'            { $$ = cc_set_next_ast_node($1, $2); }
-    | command ';'
+    : command_rep command ';'            { $$ = cc_concat_ast_chain($1, $2); }
+    | command ';'                        { $$ = $1; }
     ;
 
+    /* declarations and blocks are sequences of their own, spliced into
+     * the enclosing one, so every command is one */
 command
-    : atrib
+    : atrib                              { $$ = cc_create_ast_chain($1); }
     | var_local
-    | control_flow
-    | io
-    | shift
-    | return
-    | call
+    | control_flow                       { $$ = cc_create_ast_chain($1); }
+    | io                                 { $$ = cc_create_ast_chain($1); }
+    | shift                              { $$ = cc_create_ast_chain($1); }
+    | return                             { $$ = cc_create_ast_chain($1); }
+    | call                               { $$ = cc_create_ast_chain($1); }
     | block
     ;
 
 block
-    : '{' '}'                            { $$ = NULL; }
+    : '{' '}'                            { $$ = cc_create_ast_chain(NULL); }
     | new_scope command_rep close_scope  { $$ = $2; }
     ;
 
 new_scope
-    : '{' { cc_push_new_scope(); }
+    : '{' { cc_push_new_scope(context); }
     ;
 
 close_scope
-    : '}' { cc_pop_top_scope(); }
+    : '}' { cc_pop_top_scope(context); }
     ;
 
 atrib
     : id tk_cmd_atrib expr       {
-        $$ = cc_create_ast_node($2, NULL, $1, $3, NULL);
-        cc_check_name_usage_scope($1->content->data.id, cc_symb_var);
+        $$ = cc_create_binary_ast_node(context, $2, $1, $3);
+        cc_check_name_usage_scope(context, $1->content, cc_symb_var);
         /* TODO: check type of expr */
     }
     | id_index tk_cmd_atrib expr {
-        $$ = cc_create_ast_node($2, NULL, $1, $3, NULL);
+        $$ = cc_create_binary_ast_node(context, $2, $1, $3);
         cc_ast_t* id_node = cc_get_nth_child_node($1, 1);
-        cc_check_name_usage_scope(id_node->content->data.id, cc_symb_array);
+        cc_check_name_usage_scope(context, id_node->content, cc_symb_array);
         /* TODO: check type of expr */
     }
     ;
@@ -254,21 +289,18 @@ var_local
 
     /* again, we can have multiple variables being declared at once */
 id_var_local_rep
-    : id_var_local
-    | id_var_local_rep ',' id_var_local { $$ = cc_set_next_ast_node($1, $3); }
+    : id_var_local                      { $$ = cc_create_ast_chain($1); }
+    | id_var_local_rep ',' id_var_local { $$ = cc_append_ast_chain($1, $3); }
     ;
 
     /* and they can be initialized (using <=) */
 id_var_local
-    : id                     {
-        $$ = NULL;
-        cc_free_ast_node($1);
-    }
+    : id                     { $$ = NULL; }
     | id tk_cmd_init id      {
-        $$ = cc_create_ast_node($2, NULL, $1, $3, NULL);
+        $$ = cc_create_binary_ast_node(context, $2, $1, $3);
     }
     | id tk_cmd_init literal {
-        $$ = cc_create_ast_node($2, NULL, $1, $3, NULL);
+        $$ = cc_create_binary_ast_node(context, $2, $1, $3);
     }
     ;
 
@@ -280,127 +312,87 @@ control_flow
 
 if
     : TK_PR_IF '(' expr ')' block                  {
-        $$ = cc_create_ast_node($1, NULL, $3, $5, NULL);
+        $$ = cc_create_binary_ast_node(context, $1, $3, $5.head);
     }
     | TK_PR_IF '(' expr ')' block TK_PR_ELSE block {
-        $$ = cc_create_ast_node($1, NULL, $3, $5, $7, NULL);
+        $$ = cc_create_ternary_ast_node(context, $1, $3, $5.head, $7.head);
     }
     ;
 
 for
     : TK_PR_FOR '(' atrib ':' expr ':' atrib ')' block {
-        $$ = cc_create_ast_node($1, NULL, $3, $5, $7, $9, NULL);
+        $$ = cc_create_quaternary_ast_node(context, $1, $3, $5, $7, $9.head);
     }
     ;
 
 while
     : TK_PR_WHILE '(' expr ')' TK_PR_DO block {
-        $$ = cc_create_ast_node($1, NULL, $3, $6, NULL);
+        $$ = cc_create_binary_ast_node(context, $1, $3, $6.head);
     }
     ;
 
 io
-    : TK_PR_INPUT id       { $$ = cc_create_ast_node($1, NULL, $2, NULL); }
-    | TK_PR_OUTPUT id      { $$ = cc_create_ast_node($1, NULL, $2, NULL); }
-    | TK_PR_OUTPUT literal { $$ = cc_create_ast_node($1, NULL, $2, NULL); }
+    : TK_PR_INPUT id       { $$ = cc_create_unary_ast_node(context, $1, $2); }
+    | TK_PR_OUTPUT id      { $$ = cc_create_unary_ast_node(context, $1, $2); }
+    | TK_PR_OUTPUT literal { $$ = cc_create_unary_ast_node(context, $1, $2); }
     ;
 
 shift
-    : id tk_cmd_shift integer       { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    | id_index tk_cmd_shift integer { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
+    : id tk_cmd_shift integer       { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | id_index tk_cmd_shift integer { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
     ;
 
 return
-    : TK_PR_RETURN expr { $$ = cc_create_ast_node($1, NULL, $2, NULL); }
-    | TK_PR_BREAK       { $$ = cc_create_ast_node($1, NULL, NULL); }
-    | TK_PR_CONTINUE    { $$ = cc_create_ast_node($1, NULL, NULL); }
+    : TK_PR_RETURN expr { $$ = cc_create_unary_ast_node(context, $1, $2); }
+    | TK_PR_BREAK       { $$ = cc_create_leaf_ast_node(context, $1); }
+    | TK_PR_CONTINUE    { $$ = cc_create_leaf_ast_node(context, $1); }
     ;
 
 call
     : TK_IDENTIFICADOR '(' param_rep ')' {
         $1->kind = cc_call;
-        $$ = cc_create_ast_node($1, NULL, $3, NULL);
+        $$ = cc_create_unary_ast_node(context, $1, $3.head);
     }
     | TK_IDENTIFICADOR '(' ')' {
         $1->kind = cc_call;
-        $$ = cc_create_ast_node($1, NULL, NULL);
+        $$ = cc_create_leaf_ast_node(context, $1);
     }
     ;
 
 param_rep
-    : expr
-    | param_rep ',' expr { $$ = cc_set_next_ast_node($1, $3); }
+    : expr               { $$ = cc_create_ast_chain($1); }
+    | param_rep ',' expr { $$ = cc_append_ast_chain($1, $3); }
     ;
 
     /* ---------- EXPRESSIONS ---------- */
 
-    /* the expression rules are implemented following precedence orders */
+    /* the precedence of each binary operator is given by its token, as
+     * the rules themselves have none */
 expr
-    : op_tern
-    ;
-
-op_tern
-    : op_log
-
-    | op_log '?' op_tern ':' op_tern {
-        cc_lexic_value_t* node_content = cc_create_lexic_value(
+    : expr '?' expr ':' expr       {
+        cc_lexic_value_t* node_content = cc_create_lexic_value(context, 
             (cc_node_data_t) { .expr = cc_expr_tern },
-            cc_expr, cc_type_undef, cc_match_location());
-
-        $$ = cc_create_ast_node(node_content, NULL, $1, $3, $5, NULL);
-    }
-    ;
-
-op_log
-    : op_bws
-    | op_log tk_op_log op_bws { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_bws
-    : op_eq
-    | op_bws tk_op_bws op_eq  { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_eq
-    : op_cmp
-    | op_eq tk_op_eq op_cmp   { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_cmp
-    :  op_add
-    | op_cmp tk_op_cmp op_add { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_add
-    : op_mul
-    | op_add tk_op_add op_mul { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_mul
-    : op_exp
-    | op_mul tk_op_mul op_exp { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_exp
-    : op_un
-    | op_exp tk_op_exp op_un  { $$ = cc_create_ast_node($2, NULL, $1, $3, NULL); }
-    ;
-
-op_un
-    : tk_op_un op_un          { $$ = cc_create_ast_node($1, NULL, $2, NULL); }
-    | op_elem
-    ;
-
-op_elem
-    : id           { $$ = $1; cc_check_name_usage_scope($1->content->data.id, cc_symb_var); }
+            cc_expr, cc_type_undef, cc_match_location(context));
+
+        $$ = cc_create_ternary_ast_node(context, node_content, $1, $3, $5);
+    }
+    | expr tk_op_log expr %prec TK_OC_AND { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | expr tk_op_bws expr %prec '|'       { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | expr tk_op_eq expr %prec TK_OC_EQ   { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | expr tk_op_cmp expr %prec '<'       { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | expr tk_op_add expr %prec '+'       { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | expr tk_op_mul expr %prec '*'       { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | expr tk_op_exp expr %prec '^'       { $$ = cc_create_binary_ast_node(context, $2, $1, $3); }
+    | tk_op_un expr %prec UNARY           { $$ = cc_create_unary_ast_node(context, $1, $2); }
+    | id           { $$ = $1; cc_check_name_usage_scope(context, $1->content, cc_symb_var); }
     | id_index     {
         $$ = $1;
         cc_ast_t* id_node = cc_get_nth_child_node($1, 1);
-        cc_check_name_usage_scope(id_node->content->data.id, cc_symb_array);
+        cc_check_name_usage_scope(context, id_node->content, cc_symb_array);
     }
     | pos_int
     | pos_float
-    | call         { $$ = $1; cc_check_name_usage_scope($1->content->data.id, cc_symb_func); }
+    | call         { $$ = $1; cc_check_name_usage_scope(context, $1->content, cc_symb_func); }
     | boolean
     | '(' expr ')' { $$ = $2; }
     ;
@@ -418,106 +410,106 @@ tk_op_log
 
 tk_op_cmp
     : TK_OC_LE {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_log_le },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_log_le },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | TK_OC_GE
     | '>' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_log_gt },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_log_gt },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '<' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_log_lt },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_log_lt },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_op_add
     : '+' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_add },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_add },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '-' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_sub },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_sub },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_op_bws
     : '|' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_or },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_or },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '&' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_and },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_and },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_op_mul
     : '*' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_mul },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_mul },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '/' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_div },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_div },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '%' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_rem },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_rem },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_op_exp
     : '^' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_bin_exp },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_bin_exp },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_op_un
     : '*' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_deref },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_deref },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '&' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_addr },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_addr },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '#' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_hash },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_hash },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '+' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_sign_pos },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_sign_pos },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '-' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_sign_neg },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_sign_neg },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '!' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_negat },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_negat },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     | '?' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .expr = cc_expr_un_logic },
-                                   cc_expr, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .expr = cc_expr_un_logic },
+                                   cc_expr, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_cmd_atrib
     : '=' {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .cmd = cc_cmd_atrib },
-                                   cc_cmd, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .cmd = cc_cmd_atrib },
+                                   cc_cmd, cc_type_undef, cc_match_location(context));
     }
     ;
 
 tk_cmd_init
     : TK_OC_LE {
-        $$ = cc_create_lexic_value((cc_node_data_t) { .cmd = cc_cmd_init },
-                                   cc_cmd, cc_type_undef, cc_match_location());
+        $$ = cc_create_lexic_value(context, (cc_node_data_t) { .cmd = cc_cmd_init },
+                                   cc_cmd, cc_type_undef, cc_match_location(context));
     }
     ;
 
@@ -526,8 +518,8 @@ tk_cmd_init
 literal
     : decimal
     | boolean
-    | TK_LIT_STRING { $$ = cc_create_ast_node($1, NULL, NULL); }
-    | TK_LIT_CHAR   { $$ = cc_create_ast_node($1, NULL, NULL); }
+    | TK_LIT_STRING { $$ = cc_create_leaf_ast_node(context, $1); }
+    | TK_LIT_CHAR   { $$ = cc_create_leaf_ast_node(context, $1); }
     ;
 
 decimal
@@ -541,12 +533,12 @@ integer
     ;
 
 pos_int
-    : TK_LIT_INT { $$ = cc_create_ast_node($1, NULL, NULL); }
+    : TK_LIT_INT { $$ = cc_create_leaf_ast_node(context, $1); }
 
 sign_int
     : signal TK_LIT_INT {
         cc_invert_number_literal(&($2->data.lit), $1, cc_type_int);
-        $$ = cc_create_ast_node($2, NULL, NULL);
+        $$ = cc_create_leaf_ast_node(context, $2);
     }
 
 float
@@ -555,31 +547,31 @@ float
     ;
 
 pos_float
-    : TK_LIT_FLOAT { $$ = cc_create_ast_node($1, NULL, NULL); }
+    : TK_LIT_FLOAT { $$ = cc_create_leaf_ast_node(context, $1); }
 
 sign_float
     : signal TK_LIT_FLOAT {
         cc_invert_number_literal(&($2->data.lit), $1, cc_type_float);
-        $$ = cc_create_ast_node($2, NULL, NULL);
+        $$ = cc_create_leaf_ast_node(context, $2);
     }
 
 boolean
-    : TK_LIT_TRUE  { $$ = cc_create_ast_node($1, NULL, NULL); }
-    | TK_LIT_FALSE { $$ = cc_create_ast_node($1, NULL, NULL); }
+    : TK_LIT_TRUE  { $$ = cc_create_leaf_ast_node(context, $1); }
+    | TK_LIT_FALSE { $$ = cc_create_leaf_ast_node(context, $1); }
     ;
 
     /* ---------- MISC ----------  */
 
 id
-    : TK_IDENTIFICADOR { $$ = cc_create_ast_node($1, NULL, NULL); }
+    : TK_IDENTIFICADOR { $$ = cc_create_leaf_ast_node(context, $1); }
 
 id_index
     : id '[' expr ']' {
-        cc_lexic_value_t* node_content = cc_create_lexic_value(
+        cc_lexic_value_t* node_content = cc_create_lexic_value(context, 
             (cc_node_data_t) { .expr = cc_expr_un_index },
-            cc_expr, cc_type_undef, cc_match_location());
+            cc_expr, cc_type_undef, cc_match_location(context));
 
-        $$ = cc_create_ast_node(node_content, NULL, $1, $3, NULL);
+        $$ = cc_create_binary_ast_node(context, node_content, $1, $3);
     }
     ;
 
@@ -604,16 +596,20 @@ tk_cmd_shift
 %%
 
 void yyerror(
-    char const*  s,
+    YYLTYPE*      location,
+    cc_context_t* context,
+    char const*   s,
     /* format */ ...)
 {
+    (void)location;
+
     va_list ap;
     va_start(ap, s);
 
-    vfprintf(stderr, s, ap);
+    vfprintf(context->diagnostics, s, ap);
 
-    cc_print_location(cc_match_location(), stderr);
-    fputs("\n", stderr);
+    cc_print_location(context, cc_match_location(context), context->diagnostics);
+    fputs("\n", context->diagnostics);
 
     va_end(ap);
 
@@ -0,0 +1,407 @@
+/** @file parser/server.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "parser/server.h"
+
+/* how much is relayed at once by the client */
+#define SERVER_CHUNK_SIZE ((size_t)65536)
+
+/* the records are sent as they are in memory */
+_Static_assert(sizeof(cc_request_t) == 24, "server request must take 24 bytes");
+_Static_assert(sizeof(cc_response_t) == 24, "server response must take 24 bytes");
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/* what the server keeps from one request to the next */
+typedef struct {
+    cc_context_t* context; /** The only context, reset after each input. */
+    cc_output_t   output;  /** Where trees are exported to, in memory. */
+} cc_server_t;
+
+/* set by the handler of `SIGINT` and `SIGTERM` */
+static volatile sig_atomic_t stop_requested = 0;
+
+/**
+ * Asks the server to stop once done with the current request.
+ *
+ * @param signal the signal caught.
+ */
+static void cc_request_stop(int signal);
+
+/**
+ * Reads exactly `length` bytes from a file descriptor.
+ *
+ * @param fd the file descriptor.
+ * @param buffer where to put them.
+ * @param length how many there are.
+ *
+ * @return whether all of them were read.
+ */
+static bool cc_receive(
+    int    fd,
+    void*  buffer,
+    size_t length);
+
+/**
+ * Reads bytes from a file descriptor, passing them on to an output.
+ *
+ * @param fd the file descriptor.
+ * @param output the output.
+ * @param length how many bytes to pass on.
+ *
+ * @return whether all of them were read and written.
+ */
+static bool cc_relay(
+    int          fd,
+    cc_output_t* output,
+    uint64_t     length);
+
+/**
+ * Opens a Unix socket at the given path, listening for connections.
+ *
+ * @param path the path of the socket.
+ *
+ * @return its file descriptor, or -1 if it couldn't be set up.
+ */
+static int cc_listen_server(char const* path);
+
+/**
+ * Limits how long reading from and writing to a connection may block,
+ * after which either one fails.
+ *
+ * @param fd the file descriptor of the connection.
+ *
+ * @return whether the limits could be set.
+ */
+static bool cc_limit_connection(int fd);
+
+/**
+ * Connects to a server listening at the given path.
+ *
+ * @param path the path of the socket.
+ *
+ * @return the file descriptor of the connection, or -1.
+ */
+static int cc_connect_server(char const* path);
+
+/**
+ * Serves the request on a connection, answering it.
+ *
+ * @param server the state of the server.
+ * @param fd the file descriptor of the connection.
+ *
+ * @return whether the server is to go on serving.
+ */
+static bool cc_serve_request(
+    cc_server_t* server,
+    int          fd);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_request_stop(int signal)
+{
+    (void)signal;
+    stop_requested = 1;
+
+    return;
+}
+
+bool cc_receive(
+    int    fd,
+    void*  buffer,
+    size_t length)
+{
+    size_t received = 0;
+
+    while (received < length) {
+        ssize_t ret = read(fd, (char*)buffer + received, length - received);
+
+        if (ret > 0)
+            received += (size_t)ret;
+        else if (ret == 0 || errno != EINTR)
+            return false;
+    }
+
+    return true;
+}
+
+bool cc_relay(
+    int          fd,
+    cc_output_t* output,
+    uint64_t     length)
+{
+    char chunk[SERVER_CHUNK_SIZE];
+
+    while (length > 0) {
+        size_t size = length < sizeof(chunk) ? (size_t)length : sizeof(chunk);
+
+        if (!cc_receive(fd, chunk, size))
+            return false;
+
+        cc_put_output(output, chunk, size);
+        length -= size;
+    }
+
+    return cc_flush_output(output);
+}
+
+int cc_listen_server(char const* path)
+{
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    size_t             length  = strlen(path);
+    struct stat        info;
+
+    if (length >= sizeof(address.sun_path))
+        return -1;
+
+    memcpy(address.sun_path, path, length + 1);
+
+    /* a server that wasn't stopped leaves its socket behind, but nothing
+     * else at the path is ever removed */
+    if (lstat(path, &info) == 0 && S_ISSOCK(info.st_mode))
+        unlink(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0)
+        return -1;
+
+    /* the socket is made as `bind` creates it, where anyone could reach
+     * it otherwise, so other users never get to connect */
+    mode_t mask  = umask(S_IRWXG | S_IRWXO);
+    int    bound = bind(fd, (struct sockaddr*)&address, sizeof(address));
+
+    umask(mask);
+
+    if (bound != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool cc_limit_connection(int fd)
+{
+    struct timeval timeout = { .tv_sec = SERVER_TIMEOUT };
+
+    return setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0
+        && setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+int cc_connect_server(char const* path)
+{
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    size_t             length  = strlen(path);
+
+    if (length >= sizeof(address.sun_path))
+        return -1;
+
+    memcpy(address.sun_path, path, length + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0)
+        return -1;
+
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool cc_serve_request(
+    cc_server_t* server,
+    int          fd)
+{
+    cc_request_t request;
+
+    /* anything that isn't a request is just hung up on */
+    if (!cc_receive(fd, &request, sizeof(request))
+        || memcmp(request.magic, SERVER_REQUEST_MAGIC, sizeof(request.magic)) != 0
+        || request.emit > cc_emit_binary
+        || request.length > MAX_SERVER_INPUT_SIZE)
+        return true;
+
+    bool          stop     = (request.flags & SERVER_STOP) != 0;
+    cc_response_t response = {
+        .magic  = SERVER_RESPONSE_MAGIC,
+        .result = 0,
+    };
+
+    char*  diagnostics        = NULL;
+    size_t diagnostics_length = 0;
+
+    server->output.length = 0;
+
+    if (!stop) {
+        cc_input_t* input = cc_create_input((size_t)request.length);
+
+        if (!cc_receive(fd, input->text, input->length)) {
+            cc_close_input(input);
+            return true;
+        }
+
+        cc_driver_options_t options = {
+            .fast_lexer = (request.flags & SERVER_FAST_LEXER) != 0,
+            .pre_lex    = (request.flags & SERVER_PRE_LEX) != 0,
+            .compact    = (request.flags & SERVER_COMPACT) != 0,
+            .emit       = (cc_emit_t)request.emit,
+        };
+
+        cc_context_t* context = server->context;
+        FILE*         stream  = open_memstream(&diagnostics, &diagnostics_length);
+
+        context->diagnostics = stream != NULL ? stream : stderr;
+
+        response.result = cc_compile_context(context, input, &server->output, &options);
+
+        if (stream != NULL)
+            fclose(stream);
+
+        /* the context still points into the input until reset */
+        cc_reset_context(context);
+        cc_close_input(input);
+    }
+
+    response.diagnostics_length = diagnostics_length;
+    response.output_length      = server->output.length;
+
+    cc_output_t reply;
+
+    cc_init_output(&reply, fd);
+    cc_put_output(&reply, (char const*)&response, sizeof(response));
+
+    if (diagnostics != NULL)
+        cc_put_output(&reply, diagnostics, diagnostics_length);
+
+    cc_put_output(&reply, server->output.buffer, server->output.length);
+    cc_flush_output(&reply);
+    cc_free_output(&reply);
+
+    free(diagnostics);
+
+    return !stop;
+}
+
+int cc_serve(char const* path)
+{
+    int listener = cc_listen_server(path);
+
+    if (listener < 0)
+        return -1;
+
+    /* without `SA_RESTART`, a signal also breaks out of `accept` */
+    struct sigaction action = { .sa_handler = cc_request_stop };
+
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    /* a client gone before its answer mustn't take the server along */
+    signal(SIGPIPE, SIG_IGN);
+
+    cc_server_t server = { .context = cc_create_context() };
+
+    cc_init_output(&server.output, NO_OUTPUT_FD);
+
+    bool serving = true;
+
+    while (serving && !stop_requested) {
+        int fd = accept(listener, NULL, NULL);
+
+        if (fd < 0)
+            continue;
+
+        /* a stalled client fails its reads and writes, and is hung up on */
+        if (cc_limit_connection(fd))
+            serving = cc_serve_request(&server, fd);
+
+        close(fd);
+    }
+
+    cc_free_output(&server.output);
+    cc_free_context(server.context);
+
+    close(listener);
+    unlink(path);
+
+    return 0;
+}
+
+bool cc_ask_server(
+    char const*       path,
+    uint32_t          flags,
+    cc_emit_t         emit,
+    cc_input_t const* input,
+    int*              result)
+{
+    int fd = cc_connect_server(path);
+
+    if (fd < 0)
+        return false;
+
+    cc_request_t request = {
+        .magic    = SERVER_REQUEST_MAGIC,
+        .flags    = flags,
+        .emit     = (uint32_t)emit,
+        .reserved = 0,
+        .length   = input != NULL ? input->length : 0,
+    };
+
+    cc_output_t   output;
+    cc_response_t response;
+
+    signal(SIGPIPE, SIG_IGN);
+    cc_init_output(&output, fd);
+    cc_put_output(&output, (char const*)&request, sizeof(request));
+
+    if (input != NULL)
+        cc_put_output(&output, input->text, input->length);
+
+    bool ok = cc_flush_output(&output)
+        && cc_receive(fd, &response, sizeof(response))
+        && memcmp(response.magic, SERVER_RESPONSE_MAGIC, sizeof(response.magic)) == 0;
+
+    if (ok) {
+        output.fd = STDERR_FILENO;
+        ok        = cc_relay(fd, &output, response.diagnostics_length);
+    }
+
+    if (ok) {
+        output.fd = STDOUT_FILENO;
+        ok        = cc_relay(fd, &output, response.output_length);
+    }
+
+    if (ok)
+        *result = response.result;
+
+    cc_free_output(&output);
+    close(fd);
+
+    return ok;
+}
@@ -0,0 +1,153 @@
+/** @file parser/stream.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "lexer/fast.h"
+#include "lexer/tools.h"
+#include "parser/stream.h"
+#include "utils/debug.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Hands every token up to where the input was scanned to the parser,
+ * stopping early if it's done.
+ *
+ * @param stream the stream.
+ * @param partial whether more input may still come.
+ */
+static void cc_push_tokens_stream(
+    cc_stream_t* stream,
+    bool         partial);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_push_tokens_stream(
+    cc_stream_t* stream,
+    bool         partial)
+{
+    cc_context_t* context = stream->context;
+    YYSTYPE       value;
+
+    cc_extend_text_buffer(context, stream->text, stream->length);
+    cc_extend_input_fast_lexer(context, stream->text, stream->scanned, partial);
+
+    while (stream->status == YYPUSH_MORE) {
+        int token = cc_fast_lex(&value, context);
+
+        /* the scanner stops short of the end while the input is partial */
+        if (token == 0)
+            break;
+
+        stream->status = yypush_parse(stream->parser, token, &value, &context->location, context);
+    }
+
+    return;
+}
+
+cc_stream_t* cc_create_stream(cc_context_t* context)
+{
+    cc_stream_t* stream = (cc_stream_t*)cc_try_malloc(sizeof(cc_stream_t), cc_mem_text);
+
+    stream->context  = context;
+    stream->parser   = yypstate_new();
+    stream->capacity = DEFAULT_STREAM_BUFFER_SIZE;
+    stream->text     = (char*)cc_try_malloc(stream->capacity + 2, cc_mem_text);
+    stream->length   = 0;
+    stream->scanned  = 0;
+    stream->status   = YYPUSH_MORE;
+
+    if (stream->parser == NULL)
+        cc_die("out of memory", CC_ERR_OOMEM);
+
+    stream->text[0] = stream->text[1] = '\0';
+
+    context->fast_lexer = true;
+    context->line       = 1;
+    cc_set_text_buffer(context, stream->text, 0);
+    cc_set_input_fast_lexer(context, stream->text, 0);
+
+    return stream;
+}
+
+int cc_feed_stream(
+    cc_stream_t* stream,
+    char const*  chunk,
+    size_t       length)
+{
+    if (stream->status != YYPUSH_MORE || length == 0)
+        return stream->status;
+
+    if (stream->length + length > stream->capacity) {
+        while (stream->length + length > stream->capacity)
+            stream->capacity *= 2;
+
+        stream->text = (char*)cc_try_realloc(stream->text, stream->capacity + 2, cc_mem_text);
+    }
+
+    size_t start = stream->length;
+
+    memcpy(stream->text + stream->length, chunk, length);
+    stream->length += length;
+    stream->text[stream->length] = stream->text[stream->length + 1] = '\0';
+
+    /* no token but comments spans lines, so everything up to the last
+     * newline of the chunk can be scanned already */
+    size_t end = stream->length;
+
+    while (end > start && stream->text[end - 1] != '\n')
+        end--;
+
+    if (end == start)
+        return stream->status;
+
+    stream->scanned = end;
+    cc_push_tokens_stream(stream, true);
+
+    return stream->status;
+}
+
+int cc_finish_stream(cc_stream_t* stream)
+{
+    if (stream->status != YYPUSH_MORE)
+        return stream->status;
+
+    stream->scanned = stream->length;
+    cc_push_tokens_stream(stream, false);
+
+    /* and then the end of the input */
+    if (stream->status == YYPUSH_MORE)
+        stream->status = yypush_parse(stream->parser, 0, NULL, &stream->context->location, stream->context);
+
+    return stream->status;
+}
+
+void cc_free_stream(cc_stream_t* stream)
+{
+    if (stream == NULL)
+        return;
+
+    /* the lines printed by diagnostics were in our copy of the input */
+    cc_free_text_buffer(stream->context);
+    cc_set_input_fast_lexer(stream->context, NULL, 0);
+
+    yypstate_delete(stream->parser);
+    cc_free(stream->text);
+    cc_free(stream);
+
+    return;
+}
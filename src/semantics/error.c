@@ -12,8 +12,10 @@
  */
 
 #include "semantics/error.h"
+#include "parser/context.h"
 
 void cc_semantic_error(
+    cc_context_t*       context,
     cc_error_t          error,
     unsigned int        num_locations,
     /* cc_location_t */ ...)
@@ -21,56 +23,56 @@ void cc_semantic_error(
     va_list ap;
     va_start(ap, num_locations);
 
-    fputs("error: ", stderr);
+    fputs("error: ", context->diagnostics);
 
     switch (error) {
     case CC_ERR_UNDECLARED:
-        fputs("undeclared identifier symbol\n", stderr);
+        fputs("undeclared identifier symbol\n", context->diagnostics);
         break;
     case CC_ERR_DECLARED:
-        fputs("symbol was already declared\n", stderr);
+        fputs("symbol was already declared\n", context->diagnostics);
         break;
     case CC_ERR_VARIABLE:
-        fputs("variable symbol used as one of another kind\n", stderr);
+        fputs("variable symbol used as one of another kind\n", context->diagnostics);
         break;
     case CC_ERR_VECTOR:
-        fputs("vector symbol used as one of another kind\n", stderr);
+        fputs("vector symbol used as one of another kind\n", context->diagnostics);
         break;
     case CC_ERR_FUNCTION:
-        fputs("function symbol used as one of another kind\n", stderr);
+        fputs("function symbol used as one of another kind\n", context->diagnostics);
         break;
     case CC_ERR_WRONG_TYPE:
-        fputs("value type incompatible to symbol type\n", stderr);
+        fputs("value type incompatible to symbol type\n", context->diagnostics);
         break;
     case CC_ERR_STRING_TO_X:
-        fputs("conversion of string symbol\n", stderr);
+        fputs("conversion of string symbol\n", context->diagnostics);
         break;
     case CC_ERR_CHAR_TO_X:
-        fputs("conversion of character symbol\n", stderr);
+        fputs("conversion of character symbol\n", context->diagnostics);
         break;
     case CC_ERR_STRING_SIZE:
-        fputs("receiving string symbol of incompatible size\n", stderr);
+        fputs("receiving string symbol of incompatible size\n", context->diagnostics);
         break;
     case CC_ERR_MISSING_ARGS:
-        fputs("function symbol received less arguments than expected\n", stderr);
+        fputs("function symbol received less arguments than expected\n", context->diagnostics);
         break;
     case CC_ERR_EXCESS_ARGS:
-        fputs("function symbol received more arguments than expected\n", stderr);
+        fputs("function symbol received more arguments than expected\n", context->diagnostics);
         break;
     case CC_ERR_WRONG_TYPE_ARGS:
-        fputs("declared arguments of incompatible type to received symbols\n", stderr);
+        fputs("declared arguments of incompatible type to received symbols\n", context->diagnostics);
         break;
     case CC_ERR_WRONG_PAR_INPUT:
-        fputs("parameter to input incompatible to int or float\n", stderr);
+        fputs("parameter to input incompatible to int or float\n", context->diagnostics);
         break;
     case CC_ERR_WRONG_PAR_OUTPUT:
-        fputs("parameter to output incompatible to int or float\n", stderr);
+        fputs("parameter to output incompatible to int or float\n", context->diagnostics);
         break;
     case CC_ERR_WRONG_PAR_RETURN:
-        fputs("return statement type incompatible to the function's type\n", stderr);
+        fputs("return statement type incompatible to the function's type\n", context->diagnostics);
         break;
     case CC_ERR_WRONG_PAR_SHIFT:
-        fputs("shift parameter greater than 16\n", stderr);
+        fputs("shift parameter greater than 16\n", context->diagnostics);
         break;
     default:
         break;
@@ -79,8 +81,8 @@ void cc_semantic_error(
     /* print error lines accordingly */
 
     for (uint16_t i = 0; i < num_locations; i++) {
-        cc_print_location(va_arg(ap, cc_location_t), stderr);
-        fputs("\n", stderr);
+        cc_print_location(context, va_arg(ap, cc_location_t), context->diagnostics);
+        fputs("\n", context->diagnostics);
     }
 
     va_end(ap);
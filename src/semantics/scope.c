@@ -12,113 +12,225 @@
  */
 
 #include "semantics/scope.h"
+#include "parser/context.h"
 
 /* --------------------------------------------------------------------------- */
-/* Global declaration: */
+/* Static declarations: */
 
-cc_stack_t* scope = NULL;
+/**
+ * Creates a new scope level,  with its own arena. Nothing is allocated in
+ * said arena until a symbol is declared.
+ *
+ * @param depth how many levels are below the new one.
+ *
+ * @return a pointer to the scope level, allocated in dynamic memory.
+ */
+static inline cc_scope_t* cc_create_scope(uint32_t depth);
+
+/**
+ * Retrieves the scope level on top of the stack, creating the global one
+ * if needed.
+ *
+ * @param context the compilation.
+ *
+ * @return the current scope level.
+ */
+static inline cc_scope_t* cc_get_top_scope(cc_context_t* context);
+
+/**
+ * Binds a name in the given scope level, shadowing any binding of the same
+ * name from the levels below.
+ *
+ * @param context the compilation.
+ * @param level the scope level to declare in.
+ * @param name the interned name.
+ * @param symbol the symbol bound to the name.
+ *
+ * @return whether the name was new in this level.
+ */
+static bool cc_bind_symbol_scope(
+    cc_context_t* context,
+    cc_scope_t*   level,
+    char const*   name,
+    cc_symb_t*    symbol);
 
 /* --------------------------------------------------------------------------- */
 /* Function definitions: */
 
-cc_stack_t* cc_init_global_scope(void)
+cc_scope_t* cc_create_scope(uint32_t depth)
 {
-    cc_stack_t* stack = cc_create_stack(128);
-    cc_map_t*   map   = cc_create_map(DEFAULT_MAP_SIZE, &cc_free_symbol_void);
+    cc_scope_t* new_scope = (cc_scope_t*)cc_try_malloc(sizeof(cc_scope_t), cc_mem_scope);
 
-    cc_push_stack(stack, (void*)map);
+    new_scope->depth    = depth;
+    new_scope->bindings = NULL;
+    new_scope->arena    = cc_create_arena(SCOPE_ARENA_BLOCK_SIZE);
 
-    return stack;
+    return new_scope;
 }
 
-void cc_push_new_scope(void)
+cc_scope_t* cc_get_top_scope(cc_context_t* context)
 {
-    cc_map_t* new_scope_map = cc_create_map(DEFAULT_MAP_SIZE, &cc_free_symbol_void);
+    if (context->scope == NULL)
+        cc_init_global_scope(context);
+
+    return (cc_scope_t*)cc_peek_stack(context->scope);
+}
+
+bool cc_bind_symbol_scope(
+    cc_context_t* context,
+    cc_scope_t*   level,
+    char const*   name,
+    cc_symb_t*    symbol)
+{
+    cc_map_t*     symbol_table = context->symbol_table;
+    cc_binding_t* outer        = (cc_binding_t*)cc_get_entry_map(symbol_table, name);
+
+    if (outer != NULL && outer->depth == level->depth)
+        return false;
+
+    cc_binding_t* binding = (cc_binding_t*)cc_alloc_arena(level->arena, sizeof(cc_binding_t), cc_mem_scope);
+
+    binding->name     = name;
+    binding->symbol   = symbol;
+    binding->depth    = level->depth;
+    binding->shadowed = outer;
+    binding->sibling  = level->bindings;
+
+    level->bindings = binding;
+
+    if (outer == NULL)
+        cc_insert_entry_map(symbol_table, name, (void*)binding);
+    else
+        cc_set_entry_map(symbol_table, name, (void*)binding);
+
+    return true;
+}
+
+void cc_init_global_scope(cc_context_t* context)
+{
+    cc_stack_t* stack        = cc_create_stack(128);
+    cc_scope_t* global_scope = cc_create_scope(0);
+
+    context->symbol_table = cc_create_arena_map(DEFAULT_MAP_SIZE, global_scope->arena, true);
 
-    cc_push_stack(scope, (void*)new_scope_map);
+    cc_push_stack(stack, (void*)global_scope);
+
+    context->scope = stack;
 
     return;
 }
 
-void cc_pop_top_scope(void)
+void cc_push_new_scope(cc_context_t* context)
 {
-    cc_map_t* current_scope = cc_pop_stack(scope);
+    if (context->scope == NULL)
+        cc_init_global_scope(context);
 
-    cc_free_map(current_scope);
+    cc_push_stack(context->scope, (void*)cc_create_scope(context->scope->top));
 
     return;
 }
 
-void cc_add_list_scope(cc_list_t* list)
+void cc_pop_top_scope(cc_context_t* context)
 {
-    if (scope == NULL)
-        scope = cc_init_global_scope();
+    if (context->scope == NULL)
+        return;
 
-    cc_map_t*       top_scope = (cc_map_t*)cc_peek_stack(scope);
-    cc_list_node_t* it        = list->start;
+    cc_map_t*   symbol_table  = context->symbol_table;
+    cc_scope_t* current_scope = cc_pop_stack(context->scope);
 
-    while (it != NULL) {
-        cc_symb_pair_t* aux = ((cc_symb_pair_t*)it->data);
-        cc_insert_entry_map(top_scope, aux->name, (void*)aux->symbol);
+    if (current_scope == NULL)
+        return;
 
-        it = it->next;
+    /* let every name shadowed by this level be seen again */
+    for (cc_binding_t* it = current_scope->bindings; it != NULL; it = it->sibling) {
+        if (it->shadowed == NULL)
+            cc_delete_map_entry(symbol_table, it->name);
+        else
+            cc_set_entry_map(symbol_table, it->name, (void*)it->shadowed);
     }
 
-    cc_free_list(list);
+    /* the table itself lives in the global level */
+    if (current_scope->depth == 0)
+        context->symbol_table = NULL;
+
+    cc_free_arena(current_scope->arena);
+    cc_free(current_scope);
 
     return;
 }
 
-void cc_add_pair_scope(cc_symb_pair_t* pair)
+void cc_free_scope(cc_context_t* context)
 {
-    if (scope == NULL)
-        scope = cc_init_global_scope();
-
-    cc_map_t* top_scope = (cc_map_t*)cc_peek_stack(scope);
+    if (context->scope == NULL)
+        return;
 
-    cc_insert_entry_map(top_scope, pair->name, (void*)pair->symbol);
+    while (!cc_is_empty_stack(context->scope))
+        cc_pop_top_scope(context);
 
-    free(pair->name);
-    free(pair);
+    cc_free_stack(context->scope);
+    context->scope = NULL;
 
     return;
 }
 
-cc_query_answer_t cc_check_id_existence_scope(char const* name)
+void cc_add_list_scope(
+    cc_context_t* context,
+    cc_list_t*    list)
 {
-    cc_query_answer_t ret       = { cc_undeclared, NULL };
-    cc_stack_t*       aux_stack = cc_create_stack(scope->size);
-    bool              found     = false;
-    bool              current   = true;
+    if (list == NULL)
+        return;
 
-    while (!cc_is_empty_stack(scope) && found != true) {
-        cc_map_t*  current_scope = cc_pop_stack(scope);
-        cc_symb_t* symbol        = cc_get_entry_map(current_scope, name);
+    cc_scope_t*     top_scope = cc_get_top_scope(context);
+    cc_list_node_t* it        = list->start;
 
-        if (symbol != NULL) {
-            ret.where  = current == true ? cc_declared_current : cc_declared_previous;
-            ret.symbol = symbol;
+    /* make room for the whole list at once instead of growing as we go */
+    cc_reserve_map(context->symbol_table, context->symbol_table->count + list->size);
 
-            found = true;
-        }
+    while (it != NULL) {
+        cc_symb_pair_t* aux = ((cc_symb_pair_t*)it->data);
+        cc_bind_symbol_scope(context, top_scope, aux->name, aux->symbol);
 
-        cc_push_stack(aux_stack, current_scope);
-        current = false;
+        it = it->next;
     }
 
-    while (!cc_is_empty_stack(aux_stack))
-        cc_push_stack(scope, cc_pop_stack(aux_stack));
+    return;
+}
+
+void cc_add_pair_scope(
+    cc_context_t*   context,
+    cc_symb_pair_t* pair)
+{
+    cc_bind_symbol_scope(context, cc_get_top_scope(context), pair->name, pair->symbol);
+
+    cc_free_symbol_pair(pair);
+
+    return;
+}
+
+cc_query_answer_t cc_check_id_existence_scope(
+    cc_context_t* context,
+    char const*   name)
+{
+    cc_query_answer_t ret       = { cc_undeclared, NULL };
+    cc_scope_t*       top_scope = cc_get_top_scope(context);
+    cc_binding_t*     binding   = (cc_binding_t*)cc_get_entry_map(context->symbol_table, name);
 
-    cc_free_stack(aux_stack);
+    if (binding != NULL) {
+        ret.where  = binding->depth == top_scope->depth ? cc_declared_current : cc_declared_previous;
+        ret.symbol = binding->symbol;
+    }
 
     return ret;
 }
 
 void cc_check_name_usage_scope(
-    char const*    name,
-    cc_symb_kind_t kind)
+    cc_context_t*     context,
+    cc_lexic_value_t* id,
+    cc_symb_kind_t    kind)
 {
-    cc_query_answer_t answer = cc_check_id_existence_scope(name);
+    cc_query_answer_t answer = cc_check_id_existence_scope(context, id->data.id);
+
+    id->symbol = answer.symbol;
 
     if (answer.where == cc_undeclared) {
         // error!
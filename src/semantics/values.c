@@ -12,68 +12,56 @@
  */
 
 #include "semantics/values.h"
+#include "parser/context.h"
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
 
 cc_symb_t* cc_create_symbol(
+    cc_context_t*  context,
     cc_location_t  location,
     cc_symb_kind_t kind)
 {
-    cc_symb_t* new_symb = (cc_symb_t*)cc_try_malloc(sizeof(cc_symb_t));
+    if (context->symbol_arena == NULL)
+        context->symbol_arena = cc_create_arena(DEFAULT_ARENA_BLOCK_SIZE);
 
-    new_symb->location = location;
-    new_symb->kind     = kind;
-    new_symb->type     = cc_type_undef;
+    cc_symb_t* new_symb = (cc_symb_t*)cc_alloc_arena(context->symbol_arena, sizeof(cc_symb_t), cc_mem_symbol);
 
-    return new_symb;
-}
-
-void cc_free_symbol(cc_symb_t* symbol)
-{
-    if (symbol == NULL)
-        return;
+    /* arena memory isn't zeroed, and may have been used before */
+    *new_symb = (cc_symb_t) {
+        .location = location,
+        .kind     = kind,
+        .type     = cc_type_undef,
+    };
 
-    switch (symbol->kind) {
-    case cc_symb_func:
-        cc_free_list(symbol->optional_info.parameters);
-        break;
-    default:
-        break;
-    }
-
-    free(symbol);
-
-    return;
-}
-
-void cc_free_symbol_void(void* pointer)
-{
-    cc_free_symbol((cc_symb_t*)pointer);
-
-    return;
+    return new_symb;
 }
 
 cc_symb_pair_t* cc_create_symbol_pair(
+    cc_context_t*     context,
     cc_lexic_value_t* lexic_value,
     cc_symb_kind_t    kind)
 {
-    cc_symb_t*      new_symbol = cc_create_symbol(lexic_value->location, kind);
-    cc_symb_pair_t* ret        = (cc_symb_pair_t*)cc_try_malloc(sizeof(cc_symb_pair_t));
+    cc_symb_t*      new_symbol = cc_create_symbol(context, lexic_value->location, kind);
+    cc_symb_pair_t* ret        = (cc_symb_pair_t*)cc_try_malloc(sizeof(cc_symb_pair_t), cc_mem_symbol);
 
     ret->symbol = new_symbol;
-    ret->name   = strdup(lexic_value->data.id);
+    ret->name   = lexic_value->data.id;
 
-    if (kind != cc_symb_func) {
-        cc_free_lexic_value(lexic_value);
-    } else {
+    /* the declaring identifier resolves to its own symbol */
+    lexic_value->symbol = new_symbol;
+
+    /* the lexic value lives in the AST storage, so there's nothing to
+     * free if we don't need it anymore */
+    if (kind == cc_symb_func)
         ret->symbol->optional_info.temp_value = lexic_value;
-    }
 
     return ret;
 }
 
 void cc_free_symbol_pair(cc_symb_pair_t* pair)
 {
-    free(pair->name);
-    free(pair);
+    cc_free(pair);
 
     return;
 }
@@ -137,20 +125,26 @@ void cc_init_array_symbol(
 
     symbol->optional_info.quantity = lexic_value->data.lit.integer;
 
-    cc_free_lexic_value(lexic_value);
-
     return;
 }
 
 void cc_init_func_symbol(
-    cc_symb_t* symbol,
-    cc_list_t* parameters)
+    cc_context_t* context,
+    cc_symb_t*    symbol,
+    cc_list_t*    parameters)
 {
     if (symbol == NULL || parameters == NULL || symbol->kind != cc_symb_func)
         return;
 
     symbol->optional_info.parameters = parameters;
 
+    /* the symbol is carved from an arena, so the list is kept track of
+     * here to be freed */
+    if (context->parameters == NULL)
+        context->parameters = cc_create_list(cc_free_list_void);
+
+    cc_insert_list(context->parameters, parameters);
+
     return;
 }
 
@@ -174,3 +168,24 @@ bool cc_check_kind_symbol(
 {
     return symbol->kind == kind;
 }
+
+void cc_free_symbols(cc_context_t* context)
+{
+    cc_free_list(context->parameters);
+    cc_free_arena(context->symbol_arena);
+
+    context->parameters   = NULL;
+    context->symbol_arena = NULL;
+
+    return;
+}
+
+void cc_reset_symbols(cc_context_t* context)
+{
+    cc_free_list(context->parameters);
+    cc_reset_arena(context->symbol_arena);
+
+    context->parameters = NULL;
+
+    return;
+}
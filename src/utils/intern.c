@@ -0,0 +1,123 @@
+/** @file utils/intern.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include "utils/intern.h"
+
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Hashes the first `length` characters of `text` using FNV-1a.
+ *
+ * @param text the string to hash.
+ * @param length its length.
+ *
+ * @return the hash.
+ *
+ * @see https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
+ */
+static inline uint32_t cc_hash_intern(
+    char const* text,
+    size_t      length);
+
+/**
+ * Doubles the size of the pool table, rehashing every slot.
+ *
+ * @param pool the pool.
+ */
+static void cc_grow_intern_pool(cc_intern_pool_t* pool);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+uint32_t cc_hash_intern(
+    char const* text,
+    size_t      length)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+void cc_grow_intern_pool(cc_intern_pool_t* pool)
+{
+    uint32_t          old_size  = pool->size;
+    cc_intern_slot_t* old_slots = pool->slots;
+
+    pool->size  = old_size == 0 ? DEFAULT_INTERN_POOL_SIZE : old_size * 2;
+    pool->slots = (cc_intern_slot_t*)cc_try_calloc(pool->size, sizeof(cc_intern_slot_t), cc_mem_string);
+
+    for (uint32_t i = 0; i < old_size; i++) {
+        if (old_slots[i].string == NULL)
+            continue;
+
+        uint32_t index = old_slots[i].hash & (pool->size - 1);
+
+        while (pool->slots[index].string != NULL)
+            index = (index + 1) & (pool->size - 1);
+
+        pool->slots[index] = old_slots[i];
+    }
+
+    cc_free(old_slots);
+
+    return;
+}
+
+char const* cc_intern_string(
+    cc_intern_pool_t* pool,
+    char const*       text,
+    size_t            length)
+{
+    /* keep the load factor under 3/4 */
+    if ((pool->count + 1) * 4 > pool->size * 3)
+        cc_grow_intern_pool(pool);
+
+    if (pool->arena == NULL)
+        pool->arena = cc_create_arena(DEFAULT_ARENA_BLOCK_SIZE);
+
+    uint32_t hash  = cc_hash_intern(text, length);
+    uint32_t index = hash & (pool->size - 1);
+
+    while (pool->slots[index].string != NULL) {
+        cc_intern_slot_t const* slot = &pool->slots[index];
+
+        if (slot->hash == hash && slot->length == length
+            && memcmp(slot->string, text, length) == 0)
+            return slot->string;
+
+        index = (index + 1) & (pool->size - 1);
+    }
+
+    pool->slots[index].string = cc_strndup_arena(pool->arena, text, length);
+    pool->slots[index].hash   = hash;
+    pool->slots[index].length = (uint32_t)length;
+    pool->count++;
+
+    return pool->slots[index].string;
+}
+
+void cc_free_interned_strings(cc_intern_pool_t* pool)
+{
+    cc_free(pool->slots);
+    cc_free_arena(pool->arena);
+
+    *pool = (cc_intern_pool_t) { 0, 0, NULL, NULL };
+
+    return;
+}
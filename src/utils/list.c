@@ -15,12 +15,12 @@
 
 cc_list_node_t* cc_create_list_node()
 {
-    return (cc_list_node_t*)cc_try_calloc(1, sizeof(cc_list_node_t));
+    return (cc_list_node_t*)cc_try_calloc(1, sizeof(cc_list_node_t), cc_mem_list);
 }
 
 cc_list_t* cc_create_list(void (*custom_free)(void*))
 {
-    cc_list_t* new_list   = (cc_list_t*)cc_try_calloc(1, sizeof(cc_list_t));
+    cc_list_t* new_list   = (cc_list_t*)cc_try_calloc(1, sizeof(cc_list_t), cc_mem_list);
     new_list->custom_free = custom_free;
 
     return new_list;
@@ -30,11 +30,14 @@ void cc_free_list_nodes(
     cc_list_node_t* node,
     void          (*custom_free)(void*))
 {
-    if (node->next != NULL)
-        cc_free_list_nodes(node->next, custom_free);
+    while (node != NULL) {
+        cc_list_node_t* next = node->next;
 
-    (*custom_free)(node->data);
-    free(node);
+        (*custom_free)(node->data);
+        cc_free(node);
+
+        node = next;
+    }
 
     return;
 }
@@ -46,7 +49,14 @@ void cc_free_list(cc_list_t* list)
 
     cc_free_list_nodes(list->start, list->custom_free);
 
-    free(list);
+    cc_free(list);
+
+    return;
+}
+
+void cc_free_list_void(void* list)
+{
+    cc_free_list((cc_list_t*)list);
 
     return;
 }
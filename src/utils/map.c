@@ -16,6 +16,10 @@
 /* --------------------------------------------------------------------------- */
 /* Static declarations: */
 
+/* the map grows once more than 7/8 of it is occupied */
+#define MAX_LOAD_NUMERATOR   ((uint64_t)7)
+#define MAX_LOAD_DENOMINATOR ((uint64_t)8)
+
 /**
  * Hashes   a  given   key  to   an  index.   Utilizes  the   MurmurHash
  * one-byte-at-a-time `uint32_t` implementation.
@@ -29,47 +33,118 @@
 static inline uint32_t cc_hash(char const* key);
 
 /**
- * Creates a map entry in dynamic memory.
+ * Hashes a key according to the map's  policy: interned keys are hashed
+ * by address, every other key by content.
  *
- * @param key the key value.
- * @param value pointer to the contents of the key.
+ * @param map the map the key belongs to.
+ * @param key the key to hash.
  *
- * @return a pointer to the node, allocated in dynamic memory.
+ * @return an unsigned integer index between [0, 4294967295).
  */
-static inline cc_map_node_t* cc_create_entry_map(
-    char const* key,
-    void*       value);
+static inline uint32_t cc_hash_key_map(
+    cc_map_t const* map,
+    char const*     key);
+
+/**
+ * Compares two keys according to the map's policy: interned keys are the
+ * same if and only if their addresses are.
+ *
+ * @param map the map the keys belong to.
+ * @param first a key.
+ * @param second another key.
+ *
+ * @return a boolean indicating whether both keys are the same.
+ */
+static inline bool cc_same_key_map(
+    cc_map_t const* map,
+    char const*     first,
+    char const*     second);
 
 /**
- * Frees all entries in the collision list, considering `pointer` as the
- * head of the list.
+ * Allocates  a zeroed  array  of  slots, in  the  map's  arena if  it
+ * has one.
+ *
+ * @param map the map that will own the slots.
+ * @param size how many slots.
  *
- * @param pointer a pointer to the node you wish to free both it and its collision list.
- * @param custom_free the custom (or not) free function to free the value of said node(s).
+ * @return a pointer to the slots.
  */
-static inline void cc_free_entry_list_map(
-    cc_map_node_t* pointer,
-    void         (*custom_free)(void*));
+static inline cc_map_slot_t* cc_create_slots_map(
+    cc_map_t* map,
+    uint32_t  size);
 
 /**
- * Frees a map entry.
+ * Copies a key to be owned by the map, unless the map uses interned keys.
  *
- * @param pointer a pointer to the node you wish to free.
- * @param custom_free the custom (or not) free function to free the value of said node.
+ * @param map the map that will own the key.
+ * @param key the key.
+ *
+ * @return the key the map should store.
  */
-static inline void cc_free_entry_map(
-    cc_map_node_t* pointer,
-    void         (*custom_free)(void*));
+static inline char const* cc_copy_key_map(
+    cc_map_t*   map,
+    char const* key);
 
 /**
- * Adds `new_item` to the collision list (or bucket) of `existing_item`.
+ * Frees the contents of a slot, that is, its value and its key.
  *
- * @param existing_item the first item added to some index, is the start of the list.
- * @param new_item the item to be added to the collision list of this index.
+ * @param map the map that owns the slot.
+ * @param slot the slot to free.
  */
-static inline void cc_handle_collision_map(
-    cc_map_node_t* existing_item,
-    cc_map_node_t* new_item);
+static inline void cc_free_slot_map(
+    cc_map_t*      map,
+    cc_map_slot_t* slot);
+
+/**
+ * Calculates how far a slot is from the slot its hash points to.
+ *
+ * @param map the map that owns the slot.
+ * @param index the index of the slot.
+ *
+ * @return the probe distance of the slot.
+ */
+static inline uint32_t cc_probe_distance_map(
+    cc_map_t const* map,
+    uint32_t        index);
+
+/**
+ * Places  a slot  in the  map following  the Robin  Hood policy,  without
+ * checking for duplicates nor growing the map.
+ *
+ * @param map the map to place the slot in.
+ * @param slot the slot to place.
+ * @param index where to start probing from.
+ * @param distance how far `index` already is from the slot's home.
+ */
+static inline void cc_place_slot_map(
+    cc_map_t*     map,
+    cc_map_slot_t slot,
+    uint32_t      index,
+    uint32_t      distance);
+
+/**
+ * Finds the index of the slot of a given key.
+ *
+ * @param map the map to search.
+ * @param key the key we're looking for.
+ * @param hash the hash of said key.
+ *
+ * @return the index of the slot or `map->size` if there's no such key.
+ */
+static inline uint32_t cc_find_slot_map(
+    cc_map_t const* map,
+    char const*     key,
+    uint32_t        hash);
+
+/**
+ * Changes the size of the map, placing every slot again.
+ *
+ * @param map the map to resize.
+ * @param size the new size, a power of two that fits every element.
+ */
+static void cc_resize_map(
+    cc_map_t* map,
+    uint32_t  size);
 
 /* --------------------------------------------------------------------------- */
 /* Function definitions: */
@@ -87,68 +162,220 @@ uint32_t cc_hash(char const* key)
     return hash;
 }
 
-cc_map_node_t* cc_create_entry_map(
-    char const* key,
-    void*       value)
+uint32_t cc_hash_key_map(
+    cc_map_t const* map,
+    char const*     key)
+{
+    if (!map->interned_keys)
+        return cc_hash(key);
+
+    /* the lower bits of an address are mostly alignment, so mix them */
+    uint64_t address = (uint64_t)(uintptr_t)key;
+
+    return (uint32_t)((address * 0x9e3779b97f4a7c15ull) >> 32);
+}
+
+bool cc_same_key_map(
+    cc_map_t const* map,
+    char const*     first,
+    char const*     second)
+{
+    return map->interned_keys ? first == second : strcmp(first, second) == 0;
+}
+
+cc_map_slot_t* cc_create_slots_map(
+    cc_map_t* map,
+    uint32_t  size)
+{
+    if (map->arena == NULL)
+        return (cc_map_slot_t*)cc_try_calloc(size, sizeof(cc_map_slot_t), cc_mem_map);
+
+    cc_map_slot_t* slots = (cc_map_slot_t*)cc_alloc_arena(map->arena, size * sizeof(cc_map_slot_t), cc_mem_map);
+    memset(slots, 0, size * sizeof(cc_map_slot_t));
+
+    return slots;
+}
+
+char const* cc_copy_key_map(
+    cc_map_t*   map,
+    char const* key)
+{
+    if (map->interned_keys)
+        return key;
+
+    if (map->arena != NULL)
+        return cc_strndup_arena(map->arena, key, strlen(key));
+
+    return cc_try_strndup(key, strlen(key));
+}
+
+void cc_free_slot_map(
+    cc_map_t*      map,
+    cc_map_slot_t* slot)
+{
+    /* arena maps own nothing that can be freed on its own */
+    if (map->arena != NULL)
+        return;
+
+    if (map->custom_free != NULL)
+        (*map->custom_free)(slot->value);
+
+    if (!map->interned_keys)
+        cc_free((void*)slot->key);
+
+    return;
+}
+
+uint32_t cc_probe_distance_map(
+    cc_map_t const* map,
+    uint32_t        index)
+{
+    return (index - map->items[index].hash) & (map->size - 1);
+}
+
+void cc_place_slot_map(
+    cc_map_t*     map,
+    cc_map_slot_t slot,
+    uint32_t      index,
+    uint32_t      distance)
+{
+    uint32_t mask = map->size - 1;
+
+    while (map->items[index].key != NULL) {
+        uint32_t existing = cc_probe_distance_map(map, index);
+
+        /* take from the rich (close to home), give to the poor */
+        if (existing < distance) {
+            cc_map_slot_t aux  = map->items[index];
+            map->items[index]  = slot;
+            slot               = aux;
+            distance           = existing;
+        }
+
+        index = (index + 1) & mask;
+        distance++;
+    }
+
+    map->items[index] = slot;
+
+    return;
+}
+
+uint32_t cc_find_slot_map(
+    cc_map_t const* map,
+    char const*     key,
+    uint32_t        hash)
 {
-    cc_map_node_t* node = (cc_map_node_t*)cc_try_malloc(sizeof(cc_map_node_t));
+    uint32_t mask     = map->size - 1;
+    uint32_t index    = hash & mask;
+    uint32_t distance = 0;
 
-    node->key   = strdup(key);
-    node->value = value;
-    node->next  = NULL;
+    /* a key can't be further from home than whoever holds its place */
+    while (map->items[index].key != NULL && distance <= cc_probe_distance_map(map, index)) {
+        if (map->items[index].hash == hash && cc_same_key_map(map, map->items[index].key, key))
+            return index;
 
-    return node;
+        index = (index + 1) & mask;
+        distance++;
+    }
+
+    return map->size;
+}
+
+void cc_resize_map(
+    cc_map_t* map,
+    uint32_t  size)
+{
+    uint32_t       old_size  = map->size;
+    cc_map_slot_t* old_items = map->items;
+
+    map->size  = size;
+    map->items = cc_create_slots_map(map, map->size);
+
+    for (uint32_t i = 0; i < old_size; i++) {
+        if (old_items[i].key != NULL)
+            cc_place_slot_map(map, old_items[i], old_items[i].hash & (map->size - 1), 0);
+    }
+
+    /* the old slots of an arena map stay there until the arena goes */
+    if (map->arena == NULL)
+        cc_free(old_items);
+
+    return;
 }
 
 cc_map_t* cc_create_map(
     uint32_t size,
     void   (*custom_free)(void*))
 {
-    cc_map_t* map = (cc_map_t*)cc_try_malloc(sizeof(cc_map_t));
+    cc_map_t* map = (cc_map_t*)cc_try_malloc(sizeof(cc_map_t), cc_mem_map);
+    uint32_t  capacity = 1;
+
+    while (capacity < size)
+        capacity *= 2;
 
-    map->items = (cc_map_node_t**)cc_try_calloc(size, sizeof(cc_map_node_t*));
     map->custom_free = custom_free;
-    map->size  = size;
+    map->arena = NULL;
+    map->interned_keys = false;
+    map->size  = capacity;
     map->count = 0;
+    map->items = cc_create_slots_map(map, capacity);
 
     return map;
 }
 
-void cc_free_entry_list_map(
-    cc_map_node_t* pointer,
-    void         (*custom_free)(void*))
+cc_map_t* cc_create_arena_map(
+    uint32_t    size,
+    cc_arena_t* arena,
+    bool        interned_keys)
 {
-    if (pointer->next != NULL)
-        cc_free_entry_list_map(pointer->next, custom_free);
+    cc_map_t* map = (cc_map_t*)cc_alloc_arena(arena, sizeof(cc_map_t), cc_mem_map);
+    uint32_t  capacity = 1;
 
-    cc_free_entry_map(pointer, custom_free);
+    while (capacity < size)
+        capacity *= 2;
 
-    return;
+    map->custom_free = NULL;
+    map->arena = arena;
+    map->interned_keys = interned_keys;
+    map->size  = capacity;
+    map->count = 0;
+    map->items = cc_create_slots_map(map, capacity);
+
+    return map;
 }
 
-void cc_free_entry_map(
-    cc_map_node_t* pointer,
-    void         (*custom_free)(void*))
+void cc_free_map(cc_map_t* pointer)
 {
-    (*custom_free)(pointer->value);
-    free(pointer->key);
-    free(pointer);
+    /* arena maps are released along with their arena */
+    if (pointer == NULL || pointer->arena != NULL)
+        return;
+
+    for (uint32_t i = 0; i < pointer->size; i++) {
+        if (pointer->items[i].key != NULL)
+            cc_free_slot_map(pointer, &pointer->items[i]);
+    }
+
+    cc_free(pointer->items);
+    cc_free(pointer);
 
     return;
 }
 
-void cc_free_map(cc_map_t* pointer)
+void cc_reserve_map(
+    cc_map_t* map,
+    uint32_t  count)
 {
-    if (pointer == NULL)
+    if (map == NULL)
         return;
 
-    for (uint32_t i = 0; i < pointer->size; i++) {
-        if (pointer->items[i] != NULL)
-            cc_free_entry_list_map(pointer->items[i], pointer->custom_free);
-    }
+    uint32_t capacity = map->size;
 
-    free(pointer->items);
-    free(pointer);
+    while ((uint64_t)count * MAX_LOAD_DENOMINATOR > (uint64_t)capacity * MAX_LOAD_NUMERATOR)
+        capacity *= 2;
+
+    if (capacity != map->size)
+        cc_resize_map(map, capacity);
 
     return;
 }
@@ -161,59 +388,76 @@ bool cc_insert_entry_map(
     if (map == NULL || key == NULL)
         return false;
 
-    cc_map_node_t* new_item     = cc_create_entry_map(key, value);
-    uint32_t       index        = cc_hash(key) % map->size;
-    bool           success      = false;
-
-    cc_map_node_t* current_item = map->items[index];
-
-    if (current_item == NULL) {
-        /* all is fine */
-        map->items[index] = new_item;
-        map->count++;
+    uint32_t hash     = cc_hash_key_map(map, key);
+    uint32_t mask     = map->size - 1;
+    uint32_t index    = hash & mask;
+    uint32_t distance = 0;
+
+    /* look for a duplicate up until the point where the key would be,
+     * before growing, as only a key that's really new needs the room */
+    while (map->items[index].key != NULL && distance <= cc_probe_distance_map(map, index)) {
+        if (map->items[index].hash == hash && cc_same_key_map(map, map->items[index].key, key)) {
+            D_PRINTF("failed insertion to hash map because the key \"%s\" already exists\n", key);
+            return false;
+        }
+
+        index = (index + 1) & mask;
+        distance++;
+    }
 
-        success = true;
-    } else if (map->count == map->size) {
-        /* map is full! */
-        D_PRINTF("failed insertion to hash map because all %"PRIu32" items were filled\n", map->size);
+    if ((uint64_t)(map->count + 1) * MAX_LOAD_DENOMINATOR > (uint64_t)map->size * MAX_LOAD_NUMERATOR) {
+        cc_resize_map(map, map->size * 2);
 
-        success = false;
-    } else {
-        /* collision! */
-        cc_handle_collision_map(current_item, new_item);
-        map->count++;
+        /* the key is still new, but its place moved with everything else */
+        mask     = map->size - 1;
+        index    = hash & mask;
+        distance = 0;
 
-        success = true;
+        while (map->items[index].key != NULL && distance <= cc_probe_distance_map(map, index)) {
+            index = (index + 1) & mask;
+            distance++;
+        }
     }
 
-    return success;
+    cc_place_slot_map(map, (cc_map_slot_t) { cc_copy_key_map(map, key), value, hash }, index, distance);
+    map->count++;
+
+    return true;
 }
 
-void* cc_get_entry_map(
+void cc_set_entry_map(
     cc_map_t*   map,
-    char const* key)
+    char const* key,
+    void*       value)
 {
     if (map == NULL || key == NULL)
-        return NULL;
+        return;
+
+    uint32_t index = cc_find_slot_map(map, key, cc_hash_key_map(map, key));
+
+    if (index == map->size) {
+        cc_insert_entry_map(map, key, value);
+        return;
+    }
 
-    cc_map_node_t* item = map->items[cc_hash(key) % map->size];
+    if (map->arena == NULL && map->custom_free != NULL)
+        (*map->custom_free)(map->items[index].value);
 
-    while (item != NULL && strcmp(item->key, key) != 0)
-        item = item->next;
+    map->items[index].value = value;
 
-    return item != NULL ? item->value : NULL;
+    return;
 }
 
-void cc_handle_collision_map(
-    cc_map_node_t* existing_item,
-    cc_map_node_t* new_item)
+void* cc_get_entry_map(
+    cc_map_t*   map,
+    char const* key)
 {
-    while (existing_item->next != NULL)
-        existing_item = existing_item->next;
+    if (map == NULL || key == NULL)
+        return NULL;
 
-    existing_item->next = new_item;
+    uint32_t index = cc_find_slot_map(map, key, cc_hash_key_map(map, key));
 
-    return;
+    return index != map->size ? map->items[index].value : NULL;
 }
 
 void cc_delete_map_entry(
@@ -223,26 +467,25 @@ void cc_delete_map_entry(
     if (map == NULL || key == NULL)
         return;
 
-    uint32_t       index = cc_hash(key) % map->size;
-    cc_map_node_t* item  = map->items[index];
+    uint32_t mask  = map->size - 1;
+    uint32_t index = cc_find_slot_map(map, key, cc_hash_key_map(map, key));
 
-    if (item == NULL)
+    if (index == map->size)
         return;
 
-    while (item->next != NULL && strcmp(item->next->key, key) != 0)
-        item = item->next;
+    cc_free_slot_map(map, &map->items[index]);
 
-    if (item->next != NULL) {
-        cc_free_entry_map(item->next, map->custom_free);
-        cc_map_node_t* new_next = item->next->next;
+    /* shift every following displaced slot one step back home */
+    uint32_t next = (index + 1) & mask;
 
-        item->next = new_next;
-    } else if (strcmp(item->key, key) == 0) {
-        cc_free_entry_map(item, map->custom_free);
+    while (map->items[next].key != NULL && cc_probe_distance_map(map, next) > 0) {
+        map->items[index] = map->items[next];
 
-        map->items[index] = NULL;
+        index = next;
+        next  = (next + 1) & mask;
     }
 
+    map->items[index].key = NULL;
     map->count--;
 
     return;
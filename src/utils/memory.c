@@ -11,46 +11,425 @@
  * 'LICENSE', which is part of this source code package.
  */
 
+#include <stdatomic.h>
+
 #include "utils/memory.h"
 
-void* cc_try_realloc(void* pointer, size_t new_size)
+/* --------------------------------------------------------------------------- */
+/* Static declarations: */
+
+/**
+ * Every block given by the `cc_try_*` family is preceded by this header,
+ * so `cc_free` knows what it is releasing. The union keeps the block that
+ * follows it suitably aligned.
+ */
+typedef union {
+    struct {
+        size_t            size;
+        cc_mem_category_t category;
+    } info;
+    max_align_t alignment;
+} cc_mem_header_t;
+
+/**
+ * The same as `cc_mem_stats_t`,  but safe to update from many threads at
+ * once, as each compilation may run on its own.
+ */
+typedef struct {
+    atomic_size_t allocations;
+    atomic_size_t bytes;
+    atomic_size_t live;
+    atomic_size_t peak;
+} cc_mem_counters_t;
+
+/* statistics of every block requested to the system allocator */
+static cc_mem_counters_t heap_stats;
+
+/* statistics of each category, including what was carved from arenas */
+static cc_mem_counters_t category_stats[cc_mem_num_categories];
+
+/* names used when printing the report, in the same order of the enum */
+static char const* const category_names[cc_mem_num_categories] = {
+    "misc",
+    "lexic values",
+    "ast nodes",
+    "strings",
+    "symbols",
+    "map buckets",
+    "scopes",
+    "stacks",
+    "lists",
+    "text buffer",
+    "tokens",
+    "arena blocks"
+};
+
+/**
+ * Accounts for a new allocation of `size` bytes.
+ *
+ * @param stats the statistics to update.
+ * @param size the size of the allocation.
+ */
+static inline void cc_account_allocation(
+    cc_mem_counters_t* stats,
+    size_t             size);
+
+/**
+ * Accounts for the release of `size` bytes.
+ *
+ * @param stats the statistics to update.
+ * @param size the size being released.
+ */
+static inline void cc_account_release(
+    cc_mem_counters_t* stats,
+    size_t             size);
+
+/**
+ * Takes a snapshot of some statistics.
+ *
+ * @param stats the statistics to read.
+ *
+ * @return a copy of the statistics.
+ */
+static inline cc_mem_stats_t cc_load_stats(cc_mem_counters_t* stats);
+
+/**
+ * Fills in the header of a freshly allocated block and accounts for it.
+ *
+ * @param header the header of the block.
+ * @param size the usable size of the block.
+ * @param category what the memory is used for.
+ *
+ * @return the usable part of the block, right after the header.
+ */
+static inline void* cc_register_block(
+    cc_mem_header_t*  header,
+    size_t            size,
+    cc_mem_category_t category);
+
+/**
+ * Creates a new arena block able to hold `size` bytes.
+ *
+ * @param size the usable size of the block.
+ *
+ * @return a pointer to the block, allocated in dynamic memory.
+ */
+static inline cc_arena_block_t* cc_create_arena_block(size_t size);
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_account_allocation(
+    cc_mem_counters_t* stats,
+    size_t             size)
 {
-    void* new_pointer = NULL;
+    /* the statistics don't order anything, so relaxed operations do */
+    atomic_fetch_add_explicit(&stats->allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->bytes, size, memory_order_relaxed);
+
+    size_t live = atomic_fetch_add_explicit(&stats->live, size, memory_order_relaxed) + size;
+    size_t peak = atomic_load_explicit(&stats->peak, memory_order_relaxed);
+
+    while (live > peak
+           && !atomic_compare_exchange_weak_explicit(&stats->peak, &peak, live,
+                                                     memory_order_relaxed, memory_order_relaxed))
+        ;
 
-    new_pointer = realloc(pointer, new_size);
+    return;
+}
+
+void cc_account_release(
+    cc_mem_counters_t* stats,
+    size_t             size)
+{
+    atomic_fetch_sub_explicit(&stats->live, size, memory_order_relaxed);
 
-    if (new_pointer == NULL) {
-        free(pointer);
+    return;
+}
+
+cc_mem_stats_t cc_load_stats(cc_mem_counters_t* stats)
+{
+    return (cc_mem_stats_t) {
+        atomic_load_explicit(&stats->allocations, memory_order_relaxed),
+        atomic_load_explicit(&stats->bytes, memory_order_relaxed),
+        atomic_load_explicit(&stats->live, memory_order_relaxed),
+        atomic_load_explicit(&stats->peak, memory_order_relaxed)
+    };
+}
+
+void* cc_register_block(
+    cc_mem_header_t*  header,
+    size_t            size,
+    cc_mem_category_t category)
+{
+    header->info.size     = size;
+    header->info.category = category;
+
+    cc_account_allocation(&heap_stats, size);
+    cc_account_allocation(&category_stats[category], size);
+
+    return (void*)(header + 1);
+}
+
+void* cc_try_realloc(
+    void*             pointer,
+    size_t            new_size,
+    cc_mem_category_t category)
+{
+    if (pointer == NULL)
+        return cc_try_malloc(new_size, category);
+
+    cc_mem_header_t* header = (cc_mem_header_t*)pointer - 1;
+    size_t           size   = header->info.size;
+
+    category = header->info.category;
+
+    cc_mem_header_t* new_header = NULL;
+
+    if (new_size <= SIZE_MAX - sizeof(cc_mem_header_t))
+        new_header = (cc_mem_header_t*)realloc(header, sizeof(cc_mem_header_t) + new_size);
+
+    if (new_header == NULL) {
+        cc_free(pointer);
         D_PRINTF("realloc just failed! error code %u\n", CC_ERR_OOMEM);
         D_PRINTF("required size was %lu\n", new_size);
         cc_die("out of memory", CC_ERR_OOMEM);
     }
 
-    return new_pointer;
+    cc_account_release(&heap_stats, size);
+    cc_account_release(&category_stats[category], size);
+
+    return cc_register_block(new_header, new_size, category);
 }
 
-void* cc_try_malloc(size_t desired_size)
+void* cc_try_malloc(
+    size_t            desired_size,
+    cc_mem_category_t category)
 {
-    void* new_pointer = malloc(desired_size);
+    cc_mem_header_t* header = NULL;
+
+    if (desired_size <= SIZE_MAX - sizeof(cc_mem_header_t))
+        header = (cc_mem_header_t*)malloc(sizeof(cc_mem_header_t) + desired_size);
 
-    if (new_pointer == NULL) {
+    if (header == NULL) {
         D_PRINTF("malloc just failed! error code %u\n", CC_ERR_OOMEM);
         D_PRINTF("required size was %lu\n", desired_size);
         cc_die("out of memory", CC_ERR_OOMEM);
     }
 
-    return new_pointer;
+    return cc_register_block(header, desired_size, category);
 }
 
-void* cc_try_calloc(size_t quantity, size_t size)
+void* cc_try_calloc(
+    size_t            quantity,
+    size_t            size,
+    cc_mem_category_t category)
 {
-    void* new_pointer = calloc(quantity, size);
+    cc_mem_header_t* header = NULL;
 
-    if (new_pointer == NULL) {
+    if (size == 0 || quantity <= (SIZE_MAX - sizeof(cc_mem_header_t)) / size)
+        header = (cc_mem_header_t*)calloc(1, sizeof(cc_mem_header_t) + quantity * size);
+
+    if (header == NULL) {
         D_PRINTF("calloc just failed! error code %u\n", CC_ERR_OOMEM);
         D_PRINTF("required size was %lu blocks of size %lu\n", quantity, size);
         cc_die("out of memory", CC_ERR_OOMEM);
     }
 
-    return new_pointer;
+    return cc_register_block(header, quantity * size, category);
+}
+
+char* cc_try_strndup(
+    char const* text,
+    size_t      length)
+{
+    char* copy = (char*)cc_try_malloc(length + 1, cc_mem_string);
+
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+void cc_free(void* pointer)
+{
+    if (pointer == NULL)
+        return;
+
+    cc_mem_header_t* header = (cc_mem_header_t*)pointer - 1;
+
+    cc_account_release(&heap_stats, header->info.size);
+    cc_account_release(&category_stats[header->info.category], header->info.size);
+
+    free(header);
+
+    return;
+}
+
+cc_arena_block_t* cc_create_arena_block(size_t size)
+{
+    cc_arena_block_t* block = (cc_arena_block_t*)cc_try_malloc(sizeof(cc_arena_block_t) + size, cc_mem_arena);
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    return block;
+}
+
+cc_arena_t* cc_create_arena(size_t block_size)
+{
+    cc_arena_t* arena = (cc_arena_t*)cc_try_calloc(1, sizeof(cc_arena_t), cc_mem_arena);
+
+    arena->current    = NULL;
+    arena->block_size = block_size;
+
+    return arena;
+}
+
+void cc_free_arena(cc_arena_t* arena)
+{
+    if (arena == NULL)
+        return;
+
+    cc_arena_block_t* block = arena->current;
+
+    while (block != NULL) {
+        cc_arena_block_t* next = block->next;
+
+        cc_free(block);
+        block = next;
+    }
+
+    for (int i = 0; i < cc_mem_num_categories; i++)
+        cc_account_release(&category_stats[i], arena->carved[i]);
+
+    cc_free(arena);
+
+    return;
+}
+
+void cc_reset_arena(cc_arena_t* arena)
+{
+    if (arena == NULL)
+        return;
+
+    cc_arena_block_t* block = arena->current;
+    cc_arena_block_t* kept  = NULL;
+
+    /* oversized blocks are always behind the current one, if there's any
+     * regular block it's the first one found */
+    while (block != NULL) {
+        cc_arena_block_t* next = block->next;
+
+        if (kept == NULL && block->size == arena->block_size)
+            kept = block;
+        else
+            cc_free(block);
+
+        block = next;
+    }
+
+    if (kept != NULL) {
+        kept->next = NULL;
+        kept->used = 0;
+    }
+
+    for (int i = 0; i < cc_mem_num_categories; i++) {
+        cc_account_release(&category_stats[i], arena->carved[i]);
+        arena->carved[i] = 0;
+    }
+
+    arena->current = kept;
+
+    return;
+}
+
+void* cc_alloc_arena(
+    cc_arena_t*       arena,
+    size_t            size,
+    cc_mem_category_t category)
+{
+    size_t const      alignment = _Alignof(max_align_t);
+    cc_arena_block_t* block     = arena->current;
+
+    size = (size + alignment - 1) & ~(alignment - 1);
+
+    arena->carved[category] += size;
+    cc_account_allocation(&category_stats[category], size);
+
+    if (size > arena->block_size) {
+        /* oversized request, it gets a block of its own behind the
+         * current one so we don't waste what's left of the latter */
+        cc_arena_block_t* big = cc_create_arena_block(size);
+
+        big->used = size;
+
+        if (block != NULL) {
+            big->next   = block->next;
+            block->next = big;
+        } else {
+            arena->current = big;
+        }
+
+        return (void*)big->data;
+    }
+
+    if (block == NULL || block->size - block->used < size) {
+        block       = cc_create_arena_block(arena->block_size);
+        block->next = arena->current;
+
+        arena->current = block;
+    }
+
+    void* pointer = (char*)block->data + block->used;
+    block->used  += size;
+
+    return pointer;
+}
+
+char* cc_strndup_arena(
+    cc_arena_t* arena,
+    char const* text,
+    size_t      length)
+{
+    char* copy = (char*)cc_alloc_arena(arena, length + 1, cc_mem_string);
+
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+cc_mem_stats_t cc_get_memory_stats(cc_mem_category_t category)
+{
+    return cc_load_stats(&category_stats[category]);
+}
+
+cc_mem_stats_t cc_get_heap_stats(void)
+{
+    return cc_load_stats(&heap_stats);
+}
+
+void cc_print_memory_report(FILE* restrict stream)
+{
+    fprintf(stream, "%-14s %12s %14s %14s %14s\n", "category", "allocations", "bytes", "peak", "live");
+
+    for (int i = 0; i < cc_mem_num_categories; i++) {
+        cc_mem_stats_t s = cc_load_stats(&category_stats[i]);
+
+        if (s.allocations == 0)
+            continue;
+
+        fprintf(stream, "%-14s %12zu %14zu %14zu %14zu\n",
+            category_names[i], s.allocations, s.bytes, s.peak, s.live);
+    }
+
+    cc_mem_stats_t heap = cc_load_stats(&heap_stats);
+
+    fprintf(stream, "%-14s %12zu %14zu %14zu %14zu\n",
+        "heap", heap.allocations, heap.bytes, heap.peak, heap.live);
+    fputs("(objects carved from arenas are also part of the arena blocks)\n", stream);
+
+    return;
 }
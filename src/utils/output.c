@@ -0,0 +1,114 @@
+/** @file utils/output.c
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utils/output.h"
+
+/* --------------------------------------------------------------------------- */
+/* Function definitions: */
+
+void cc_init_output(
+    cc_output_t* output,
+    int          fd)
+{
+    output->fd       = fd;
+    output->failed   = false;
+    output->length   = 0;
+    output->capacity = fd == NO_OUTPUT_FD ? DEFAULT_MEMORY_OUTPUT_SIZE : DEFAULT_OUTPUT_BUFFER_SIZE;
+    output->buffer   = (char*)cc_try_malloc(output->capacity, cc_mem_misc);
+
+    return;
+}
+
+void cc_put_output(
+    cc_output_t* output,
+    char const*  text,
+    size_t       length)
+{
+    if (output->fd == NO_OUTPUT_FD && output->length + length > output->capacity) {
+        while (output->length + length > output->capacity)
+            output->capacity *= 2;
+
+        output->buffer = (char*)cc_try_realloc(output->buffer, output->capacity, cc_mem_misc);
+    }
+
+    while (output->length + length > output->capacity) {
+        size_t room = output->capacity - output->length;
+
+        /* fill the buffer up, so it's always written whole */
+        memcpy(output->buffer + output->length, text, room);
+        output->length = output->capacity;
+        cc_flush_output(output);
+
+        text   += room;
+        length -= room;
+    }
+
+    memcpy(output->buffer + output->length, text, length);
+    output->length += length;
+
+    return;
+}
+
+void cc_put_output_number(
+    cc_output_t* output,
+    uint32_t     number,
+    bool         negative)
+{
+    char  digits[11];
+    char* start = digits + sizeof(digits);
+
+    do {
+        *--start = (char)('0' + number % 10);
+        number /= 10;
+    } while (number != 0);
+
+    if (negative)
+        *--start = '-';
+
+    cc_put_output(output, start, (size_t)(digits + sizeof(digits) - start));
+
+    return;
+}
+
+bool cc_flush_output(cc_output_t* output)
+{
+    if (output->fd == NO_OUTPUT_FD)
+        return true;
+
+    size_t written = 0;
+
+    while (!output->failed && written < output->length) {
+        ssize_t ret = write(output->fd, output->buffer + written, output->length - written);
+
+        if (ret >= 0)
+            written += (size_t)ret;
+        else if (errno != EINTR)
+            output->failed = true;
+    }
+
+    output->length = 0;
+
+    return !output->failed;
+}
+
+void cc_free_output(cc_output_t* output)
+{
+    cc_free(output->buffer);
+    output->buffer = NULL;
+
+    return;
+}
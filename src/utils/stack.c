@@ -15,10 +15,10 @@
 
 cc_stack_t* cc_create_stack(uint32_t capacity)
 {
-    cc_stack_t* stack = (cc_stack_t*)cc_try_malloc(sizeof(cc_stack_t));
+    cc_stack_t* stack = (cc_stack_t*)cc_try_malloc(sizeof(cc_stack_t), cc_mem_stack);
 
     stack->size = capacity;
-    stack->data = capacity > 0 ? (void**)cc_try_calloc(capacity, sizeof(void*)) : NULL;
+    stack->data = capacity > 0 ? (void**)cc_try_calloc(capacity, sizeof(void*), cc_mem_stack) : NULL;
     stack->top  = 0;
 
     return stack;
@@ -30,8 +30,8 @@ void cc_free_stack(cc_stack_t* pointer)
         return;
 
     if (pointer->data != NULL)
-        free(pointer->data);
-    free(pointer);
+        cc_free(pointer->data);
+    cc_free(pointer);
 
     return;
 }
@@ -61,11 +61,11 @@ bool cc_push_stack(
 
     if (cc_is_full_stack(stack)) {
         D_PRINTF("failed to push to stack, all %"PRIu32" positions are full\n", stack->size);
-        void** new_region = (void**)cc_try_calloc((stack->size + 1) * 2, sizeof(void*));
+        void** new_region = (void**)cc_try_calloc((stack->size + 1) * 2, sizeof(void*), cc_mem_stack);
 
         if (stack->data != NULL) {
-            memcpy(new_region, stack->data, stack->size);
-            free(stack->data);
+            memcpy(new_region, stack->data, stack->size * sizeof(void*));
+            cc_free(stack->data);
         }
 
         stack->data  = new_region;
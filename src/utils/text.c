@@ -22,53 +22,68 @@ char* cc_text_convert_escapes(
         return NULL;
     }
 
-    char* new_string = (char*)cc_try_calloc(limit + 1, sizeof(char));
+    char* new_string = (char*)cc_try_calloc(limit + 1, sizeof(char), cc_mem_string);
+
+    memcpy(new_string, input, limit);
+
+    return cc_text_unescape(new_string, limit);
+}
+
+char* cc_text_unescape(
+    char*  string,
+    size_t limit)
+{
+    size_t j = 0;
 
     /* ESC_SEQ [abfnrtv\\\"\'] */
 
-    for (size_t i = 0, j = 0; i < limit; i++, j++) {
-        if (input[i] == '\\') {
-            switch (input[i + 1]) {
+    /* as j never overtakes i, we can safely write over what was already read */
+    for (size_t i = 0; i < limit; i++, j++) {
+        if (string[i] == '\\') {
+            switch (string[i + 1]) {
             case 'a':
-                new_string[j] = '\a';
+                string[j] = '\a';
                 break;
             case 'b':
-                new_string[j] = '\b';
+                string[j] = '\b';
                 break;
             case 'f':
-                new_string[j] = '\f';
+                string[j] = '\f';
                 break;
             case 'n':
-                new_string[j] = '\n';
+                string[j] = '\n';
                 break;
             case 'r':
-                new_string[j] = '\r';
+                string[j] = '\r';
                 break;
             case 't':
-                new_string[j] = '\t';
+                string[j] = '\t';
                 break;
             case 'v':
-                new_string[j] = '\v';
+                string[j] = '\v';
                 break;
             default:
-                new_string[j] = input[i + 1];
+                string[j] = string[i + 1];
             }
 
             i++;
         } else {
-            new_string[j] = input[i];
+            string[j] = string[i];
         }
     }
 
-    return new_string;
+    string[j] = '\0';
+
+    return string;
 }
 
 void cc_text_underline(
     size_t   size,
     uint16_t start,
-    uint16_t end)
+    uint16_t end,
+    FILE*    stream)
 {
-    char string[size];
+    char string[size + 1];
 
     for (uint16_t i = 0; i < size; i++) {
         if (i < start - 1) {
@@ -84,7 +99,7 @@ void cc_text_underline(
 
     string[size] = '\0';
 
-    fputs(string, stdout);
+    fputs(string, stream);
 
     return;
 }
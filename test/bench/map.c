@@ -0,0 +1,223 @@
+/** @file test/bench/map.c
+ *
+ * @brief Microbenchmark of the hash map.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Compares `cc_map_t` against the chained map it replaced, which is kept
+ * here as `legacy_map_t`. As the legacy map can't grow, it is created with
+ * as many buckets as there are keys, its best possible case.
+ *
+ * Usage: bench/map [number of keys]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils/map.h"
+
+/* --------------------------------------------------------------------------- */
+/* The legacy chained map: */
+
+typedef struct legacy_node_s {
+    struct legacy_node_s* next;
+    void*                 value;
+    char*                 key;
+} legacy_node_t;
+
+typedef struct {
+    uint32_t        size;
+    uint32_t        count;
+    legacy_node_t** items;
+} legacy_map_t;
+
+static uint32_t legacy_hash(char const* key)
+{
+    uint32_t hash = 3323198485ul;
+
+    for (; *key; ++key) {
+        hash ^= *key;
+        hash *= 0x5bd1e995;
+        hash ^= hash >> 15;
+    }
+
+    return hash;
+}
+
+static legacy_map_t* legacy_create(uint32_t size)
+{
+    legacy_map_t* map = (legacy_map_t*)malloc(sizeof(legacy_map_t));
+
+    map->items = (legacy_node_t**)calloc(size, sizeof(legacy_node_t*));
+    map->size  = size;
+    map->count = 0;
+
+    return map;
+}
+
+static bool legacy_insert(
+    legacy_map_t* map,
+    char const*   key,
+    void*         value)
+{
+    if (map->count == map->size)
+        return false;
+
+    legacy_node_t* node = (legacy_node_t*)malloc(sizeof(legacy_node_t));
+
+    node->key   = strdup(key);
+    node->value = value;
+    node->next  = NULL;
+
+    legacy_node_t** it = &map->items[legacy_hash(key) % map->size];
+
+    while (*it != NULL)
+        it = &(*it)->next;
+
+    *it = node;
+    map->count++;
+
+    return true;
+}
+
+static void* legacy_get(
+    legacy_map_t* map,
+    char const*   key)
+{
+    legacy_node_t* item = map->items[legacy_hash(key) % map->size];
+
+    while (item != NULL && strcmp(item->key, key) != 0)
+        item = item->next;
+
+    return item != NULL ? item->value : NULL;
+}
+
+static void legacy_free(legacy_map_t* map)
+{
+    for (uint32_t i = 0; i < map->size; i++) {
+        legacy_node_t* item = map->items[i];
+
+        while (item != NULL) {
+            legacy_node_t* next = item->next;
+
+            free(item->key);
+            free(item);
+            item = next;
+        }
+    }
+
+    free(map->items);
+    free(map);
+}
+
+/* --------------------------------------------------------------------------- */
+/* Benchmark: */
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void report(
+    char const* name,
+    char const* operation,
+    double      elapsed,
+    uint32_t    count)
+{
+    printf("%-8s %-10s %10.1f ns/op\n", name, operation, elapsed * 1e9 / count);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t const count = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 200000;
+
+    char** hits   = (char**)malloc(count * sizeof(char*));
+    char** misses = (char**)malloc(count * sizeof(char*));
+
+    for (uint32_t i = 0; i < count; i++) {
+        char buffer[32];
+
+        snprintf(buffer, sizeof(buffer), "identifier_%u", i);
+        hits[i] = strdup(buffer);
+
+        snprintf(buffer, sizeof(buffer), "missing_%u", i);
+        misses[i] = strdup(buffer);
+    }
+
+    printf("%u keys\n", count);
+
+    volatile uintptr_t sink = 0;
+    double             start;
+
+    /* legacy */
+    start = now();
+    legacy_map_t* legacy = legacy_create(count);
+    for (uint32_t i = 0; i < count; i++)
+        legacy_insert(legacy, hits[i], hits[i]);
+    report("legacy", "insert", now() - start, count);
+
+    start = now();
+    for (uint32_t i = 0; i < count; i++)
+        sink += (uintptr_t)legacy_get(legacy, hits[i]);
+    report("legacy", "hit", now() - start, count);
+
+    start = now();
+    for (uint32_t i = 0; i < count; i++)
+        sink += (uintptr_t)legacy_get(legacy, misses[i]);
+    report("legacy", "miss", now() - start, count);
+
+    start = now();
+    legacy_free(legacy);
+    report("legacy", "free", now() - start, count);
+
+    /* current, starting from the default size */
+    start = now();
+    cc_map_t* map = cc_create_map(DEFAULT_MAP_SIZE, NULL);
+    for (uint32_t i = 0; i < count; i++)
+        cc_insert_entry_map(map, hits[i], hits[i]);
+    report("cc_map", "insert", now() - start, count);
+
+    start = now();
+    for (uint32_t i = 0; i < count; i++)
+        sink += (uintptr_t)cc_get_entry_map(map, hits[i]);
+    report("cc_map", "hit", now() - start, count);
+
+    start = now();
+    for (uint32_t i = 0; i < count; i++)
+        sink += (uintptr_t)cc_get_entry_map(map, misses[i]);
+    report("cc_map", "miss", now() - start, count);
+
+    start = now();
+    for (uint32_t i = 0; i < count; i += 2)
+        cc_delete_map_entry(map, hits[i]);
+    report("cc_map", "delete", now() - start, count / 2);
+
+    start = now();
+    cc_free_map(map);
+    report("cc_map", "free", now() - start, count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        free(hits[i]);
+        free(misses[i]);
+    }
+
+    free(hits);
+    free(misses);
+
+    return sink == 0;
+}
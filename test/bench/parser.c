@@ -0,0 +1,198 @@
+/** @file test/bench/parser.c
+ *
+ * @brief Microbenchmark of the construction of long sequences.
+ *
+ * @copyright (C) 2020 Henrique Silva
+ *
+ *
+ * @author Henrique Silva <hcpsilva@inf.ufrgs.br>
+ *
+ * @section LICENSE
+ *
+ * This file is subject to the terms and conditions defined in the file
+ * 'LICENSE', which is part of this source code package.
+ *
+ * @section DESCRIPTION
+ *
+ * Parses a single function with more and more statements, and then a
+ * file with more and more functions, doubling their number each round.
+ * Appending to a sequence takes constant time, so the time per statement
+ * or function must stay flat as they double; it used to double as well.
+ *
+ * Then the statements go in the innermost of nested blocks, as deep as
+ * they're many. Each block is spliced into the enclosing sequence, which
+ * takes constant time as well, so the time per statement must stay flat
+ * as both the statements and the nesting double; it used to grow with
+ * the nesting, as every block walked its statements again.
+ *
+ * Last, a function whose statements are all long expressions, mixing
+ * every precedence level, shows how fast expressions are parsed.
+ *
+ * Usage: bench/parser [number of statements]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lexer/scanner.h"
+#include "parser/context.h"
+
+/* how many times the number of items doubles */
+#define ROUNDS 4
+
+/* how many statements there are per level of nesting */
+#define NESTING_RATIO 64
+
+/* --------------------------------------------------------------------------- */
+/* Sources: */
+
+typedef struct {
+    char*  text;
+    size_t length;
+    size_t capacity;
+} source_t;
+
+static void append(
+    source_t*   source,
+    char const* text)
+{
+    size_t length = strlen(text);
+
+    /* the scanner wants two null characters after the text */
+    while (source->length + length + 2 > source->capacity) {
+        source->capacity = source->capacity == 0 ? 4096 : source->capacity * 2;
+        source->text     = (char*)realloc(source->text, source->capacity);
+    }
+
+    memcpy(source->text + source->length, text, length);
+    source->length += length;
+    source->text[source->length] = source->text[source->length + 1] = '\0';
+}
+
+/* a single function with `count` statements */
+static source_t statements(uint32_t count)
+{
+    source_t source = { NULL, 0, 0 };
+
+    append(&source, "int x;\nint main() {\n");
+    for (uint32_t i = 0; i < count; i++)
+        append(&source, "    x = 1;\n");
+    append(&source, "}\n");
+
+    return source;
+}
+
+/* `count` functions with a statement each */
+static source_t functions(uint32_t count)
+{
+    source_t source = { NULL, 0, 0 };
+
+    append(&source, "int x;\n");
+    for (uint32_t i = 0; i < count; i++) {
+        char buffer[64];
+
+        snprintf(buffer, sizeof(buffer), "int f%u() {\n    x = 1;\n}\n", i);
+        append(&source, buffer);
+    }
+
+    return source;
+}
+
+/* a single function with `count` statements, inside a block nested
+ * `count / NESTING_RATIO` levels deep */
+static source_t nested(uint32_t count)
+{
+    source_t source = { NULL, 0, 0 };
+    uint32_t depth  = count / NESTING_RATIO;
+
+    append(&source, "int x;\nint main() {\n");
+    for (uint32_t i = 0; i < depth; i++)
+        append(&source, "{\n");
+    for (uint32_t i = 0; i < count; i++)
+        append(&source, "    x = 1;\n");
+    for (uint32_t i = 0; i < depth; i++)
+        append(&source, "};\n");
+    append(&source, "}\n");
+
+    return source;
+}
+
+/* a single function with `count` statements, all of them expressions */
+static source_t expressions(uint32_t count)
+{
+    source_t source = { NULL, 0, 0 };
+
+    append(&source, "int x;\nint a;\nint b;\nint c;\nint main() {\n");
+    for (uint32_t i = 0; i < count; i++)
+        append(&source, "    x = a + b * c - (a / 2) ^ b % c > 1 && -a == b || !c ? a & b | c : x;\n");
+    append(&source, "}\n");
+
+    return source;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Benchmark: */
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static double parse(source_t* source)
+{
+    cc_input_t    input   = { source->text, source->length, 0 };
+    cc_context_t* context = cc_create_context();
+    double        start   = now();
+
+    if (!cc_scan_input(context, &input) || yyparse(context) != 0) {
+        fprintf(stderr, "could not parse the generated source\n");
+        exit(1);
+    }
+
+    double elapsed = now() - start;
+
+    cc_free_context(context);
+    free(source->text);
+
+    return elapsed;
+}
+
+static void report(
+    char const* name,
+    uint32_t    count,
+    double      elapsed)
+{
+    printf("%-11s %8u %10.3f ms %10.1f ns/item\n", name, count, elapsed * 1e3, elapsed * 1e9 / count);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t const count = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 100000;
+
+    for (uint32_t round = ROUNDS; round-- > 0;) {
+        source_t source = statements(count >> round);
+        report("statements", count >> round, parse(&source));
+    }
+
+    for (uint32_t round = ROUNDS; round-- > 0;) {
+        source_t source = functions((count / 2) >> round);
+        report("functions", (count / 2) >> round, parse(&source));
+    }
+
+    for (uint32_t round = ROUNDS; round-- > 0;) {
+        source_t source = nested(count >> round);
+        report("nested", count >> round, parse(&source));
+    }
+
+    for (uint32_t round = ROUNDS; round-- > 0;) {
+        source_t source = expressions((count / 4) >> round);
+        report("expressions", (count / 4) >> round, parse(&source));
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+## lexer.sh
+#
+# Copyright: (C) 2020 Henrique Silva
+#
+# Author: Henrique Silva <hcpsilva@inf.ufrgs.br>
+#
+# License: GNU General Public License version 3, or any later version
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+## Commentary:
+#
+# This script dumps the tokens of every test case with the flex scanner,
+# the hand-written one and from the token array, and reports any case in
+# which they disagree.
+#
+## Code:
+
+set -u
+
+TEST_DIR="$(dirname $(readlink -f $0))"
+ROOT_DIR="$(dirname $TEST_DIR)"
+EXECUTABLE="$ROOT_DIR/etapa4"
+
+failures=0
+
+for test_case in $TEST_DIR/etapa*-cases/*; do
+    expected="$($EXECUTABLE --tokens $test_case 2>&1)"
+
+    for options in "--fast-lexer" "--token-array"; do
+        if [ "$($EXECUTABLE --tokens $options $test_case 2>&1)" != "$expected" ]; then
+            echo "'$options' disagrees on '$test_case'"
+            failures=$((failures + 1))
+        fi
+    done
+done
+
+echo "$failures mismatching test cases"
+
+[ $failures -eq 0 ]
+
+## lexer.sh ends here
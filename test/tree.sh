@@ -0,0 +1,132 @@
+#!/bin/bash
+
+## tree.sh
+#
+# Copyright: (C) 2020 Henrique Silva
+#
+# Author: Henrique Silva <hcpsilva@inf.ufrgs.br>
+#
+# License: GNU General Public License version 3, or any later version
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+## Commentary:
+#
+# This script builds the tree of every test case in each of the ways it
+# can be built: parsing the whole input, streaming it through a pipe a
+# few bytes at a time and making a compact copy of the tree. It reports
+# any case in which the trees (with their addresses numbered in order of
+# appearance) or the results disagree. The trees exported with '--dot'
+# are numbered that way already. Trees that parse are also written to a
+# binary tree file and loaded back. If the client was built, the cases
+# are also compiled by a server, one after the other.
+#
+## Code:
+
+set -u
+
+TEST_DIR="$(dirname $(readlink -f $0))"
+ROOT_DIR="$(dirname $TEST_DIR)"
+EXECUTABLE="$ROOT_DIR/etapa4"
+CLIENT="$ROOT_DIR/build/client"
+
+# the nodes are named by their addresses, which differ from run to run
+renumber() {
+    awk '{
+        line = ""
+        while (match($0, /0x[0-9a-f]+/)) {
+            address = substr($0, RSTART, RLENGTH)
+            if (!(address in names))
+                names[address] = count++
+            line = line substr($0, 1, RSTART - 1) names[address]
+            $0 = substr($0, RSTART + RLENGTH)
+        }
+        print line $0
+    }'
+}
+
+failures=0
+
+for test_case in $TEST_DIR/etapa*-cases/*; do
+    expected="$($EXECUTABLE --fast-lexer $test_case 2>&1 | renumber; echo ${PIPESTATUS[0]})"
+    streamed="$(dd if=$test_case bs=7 status=none | $EXECUTABLE --stream 2>&1 | renumber; echo ${PIPESTATUS[1]})"
+    compact="$($EXECUTABLE --fast-lexer --compact $test_case 2>&1 | renumber; echo ${PIPESTATUS[0]})"
+    dot="$($EXECUTABLE --fast-lexer --dot $test_case 2>&1; echo $?)"
+    compact_dot="$($EXECUTABLE --fast-lexer --compact --dot $test_case 2>&1; echo $?)"
+    loaded="$($EXECUTABLE --fast-lexer --emit=binary $test_case 2>/dev/null | $EXECUTABLE --load --dot 2>&1; echo ${PIPESTATUS[1]})"
+
+    if [ "$streamed" != "$expected" ]; then
+        echo "'--stream' disagrees on '$test_case'"
+        failures=$((failures + 1))
+    fi
+
+    if [ "$compact" != "$expected" ]; then
+        echo "'--compact' disagrees on '$test_case'"
+        failures=$((failures + 1))
+    fi
+
+    if [ "$dot" != "$expected" ]; then
+        echo "'--dot' disagrees on '$test_case'"
+        failures=$((failures + 1))
+    fi
+
+    if [ "$compact_dot" != "$expected" ]; then
+        echo "'--compact --dot' disagrees on '$test_case'"
+        failures=$((failures + 1))
+    fi
+
+    # the last line is the result of parsing
+    if [ "${dot##*$'\n'}" = 0 ] && [ "$loaded" != "$dot" ]; then
+        echo "'--load' disagrees on '$test_case'"
+        failures=$((failures + 1))
+    fi
+done
+
+# many inputs at once come out just as if compiled one by one
+one_by_one="$(for test_case in $TEST_DIR/etapa*-cases/*; do $EXECUTABLE --fast-lexer --dot $test_case 2>/dev/null; done)"
+all_at_once="$($EXECUTABLE --fast-lexer --dot -j 4 $TEST_DIR/etapa*-cases/* 2>/dev/null)"
+
+if [ "$all_at_once" != "$one_by_one" ]; then
+    echo "'-j' disagrees with compiling one input at a time"
+    failures=$((failures + 1))
+fi
+
+# a server keeps its context from one case to the next
+if [ -x "$CLIENT" ]; then
+    socket="$(mktemp -u)"
+
+    $EXECUTABLE --serve="$socket" &
+
+    # wait for the server to be listening
+    for _ in $(seq 50); do
+        [ -S "$socket" ] && break
+        sleep 0.1
+    done
+
+    for test_case in $TEST_DIR/etapa*-cases/*; do
+        served="$($CLIENT --socket="$socket" --fast-lexer $test_case 2>&1; echo $?)"
+        dot="$($EXECUTABLE --fast-lexer --dot $test_case 2>&1; echo $?)"
+
+        if [ "$served" != "$dot" ]; then
+            echo "the server disagrees on '$test_case'"
+            failures=$((failures + 1))
+        fi
+    done
+
+    $CLIENT --socket="$socket" --stop
+    wait
+fi
+
+echo "$failures mismatching test cases"
+
+[ $failures -eq 0 ]
+
+## tree.sh ends here